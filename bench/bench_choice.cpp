@@ -0,0 +1,68 @@
+/*
+ * World VTT / cpp_config – benchmarki walidacji ConfigChoice
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "ConfigChoice.h"
+
+using namespace cpp_config;
+
+static std::vector<std::string> MakeChoices(int64_t count)
+{
+    std::vector<std::string> choices;
+    for (int64_t i = 0; i < count; ++i) {
+        choices.push_back("region-" + std::to_string(i));
+    }
+    return choices;
+}
+
+// Ostatnia pozycja listy – najgorszy przypadek dawnego wyszukiwania liniowego
+static void BM_ChoiceSet(benchmark::State& state)
+{
+    std::vector<std::string> choices = MakeChoices(state.range(0));
+    ConfigChoice c("region", "Region", choices.front(), choices);
+    const std::string& last = choices.back();
+    for (auto _ : state) {
+        c.set(last);
+    }
+}
+BENCHMARK(BM_ChoiceSet)->RangeMultiplier(4)->Range(4, 4096);
+
+static void BM_ChoiceSetRejected(benchmark::State& state)
+{
+    std::vector<std::string> choices = MakeChoices(state.range(0));
+    ConfigChoice c("region", "Region", choices.front(), choices);
+    for (auto _ : state) {
+        try {
+            c.set("unknown-region");
+        } catch (const std::exception& e) {
+            benchmark::DoNotOptimize(e.what());
+        }
+    }
+}
+BENCHMARK(BM_ChoiceSetRejected)->RangeMultiplier(4)->Range(4, 4096);
+
+static void BM_ChoiceRead(benchmark::State& state)
+{
+    std::vector<std::string> choices = MakeChoices(state.range(0));
+    ConfigChoice c("region", "Region", choices.back(), choices);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(c.as<std::string>());
+    }
+}
+BENCHMARK(BM_ChoiceRead)->Arg(4)->Arg(4096);
+
+static void BM_ChoiceIndex(benchmark::State& state)
+{
+    std::vector<std::string> choices = MakeChoices(state.range(0));
+    ConfigChoice c("region", "Region", choices.back(), choices);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(c.index());
+        benchmark::DoNotOptimize(c.choice());
+    }
+}
+BENCHMARK(BM_ChoiceIndex)->Arg(4)->Arg(4096);
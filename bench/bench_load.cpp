@@ -0,0 +1,508 @@
+/*
+ * World VTT / cpp_config – benchmarki wczytywania
+ *
+ * Przepustowość wczytywania w zależności od rozmiaru pliku i liczby
+ * zarejestrowanych kluczy, tokenizacja, rozwiązywanie nazw oraz start
+ * z binarnym cache.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Config.h"
+#include "ConfigBatch.h"
+#include "ConfigNameIndex.h"
+#include "ConfigParameter.h"
+#include "ConfigParser.h"
+#include "ConfigSources.h"
+#include "ConfigThreadPool.h"
+
+using namespace cpp_config;
+
+// Duży, wygenerowany schemat: klucze key_0 .. key_1023
+enum class LoadBenchParam : int
+{
+    Count = 1024,
+};
+
+using LoadBenchConfig = Config<LoadBenchParam>;
+
+namespace cpp_config {
+template<>
+const std::string Config<LoadBenchParam>::_confFileName = "bench_load_config.cfg";
+}  // namespace cpp_config
+
+static constexpr int64_t kMaxLoadKeys = static_cast<int64_t>(LoadBenchParam::Count);
+
+// Co druga linia trafia w jeden z `keys` zarejestrowanych parametrów, reszta jest ignorowana
+static void WriteLoadFile(const std::string& path, int64_t lines, int64_t keys, int64_t salt = 0)
+{
+    std::ofstream out(path);
+    out << "# generated\n";
+    for (int64_t i = 0; i < lines; ++i) {
+        int64_t key = i % (2 * keys);
+        out << (key < keys ? "key_" : "unknown_") << key << "=" << i + salt << "\n";
+    }
+}
+
+static void RegisterLoadParams(int64_t keys)
+{
+    auto& cfg = LoadBenchConfig::instance();
+    cfg.clear();
+    for (int64_t i = 0; i < keys; ++i) {
+        cfg.addParam(static_cast<LoadBenchParam>(i), std::make_shared<ConfigParameter>("key_" + std::to_string(i), "d", "0"));
+    }
+    cfg.freeze();
+}
+
+static std::shared_ptr<const LoadBenchConfig::Schema> MakeLoadSchema(int64_t keys)
+{
+    LoadBenchConfig::Schema::Builder builder;
+    for (int64_t i = 0; i < keys; ++i) {
+        builder.add(static_cast<LoadBenchParam>(i), std::make_shared<ConfigParameter>("key_" + std::to_string(i), "d", "0"));
+    }
+    return builder.build();
+}
+
+static void PointConfigAt(const std::string& target)
+{
+    std::filesystem::remove("bench_load_config.cfg");
+    std::filesystem::create_symlink(target, "bench_load_config.cfg");
+}
+
+// ===================================================
+//  Rozwiązywanie nazw parametrów
+// ===================================================
+
+static std::map<std::string, int, std::less<>> MakeNames(int64_t count)
+{
+    std::map<std::string, int, std::less<>> names;
+    for (int64_t i = 0; i < count; ++i) {
+        names["generated.section_" + std::to_string(i % 97) + ".param_" + std::to_string(i)] = static_cast<int>(i);
+    }
+    return names;
+}
+
+static void BM_NameLookupMap(benchmark::State& state)
+{
+    auto names = MakeNames(state.range(0));
+    std::vector<std::string> queries;
+    for (const auto& [name, key] : names) {
+        queries.push_back(name);
+    }
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(names.find(std::string_view(queries[i++ % queries.size()])));
+    }
+}
+BENCHMARK(BM_NameLookupMap)->Arg(64)->Arg(4096)->Arg(100000);
+
+static void BM_NameLookupIndex(benchmark::State& state)
+{
+    auto names = MakeNames(state.range(0));
+    NameIndex<int> index(names);
+    std::vector<std::string> queries;
+    for (const auto& [name, key] : names) {
+        queries.push_back(name);
+    }
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index.find(queries[i++ % queries.size()]));
+    }
+}
+BENCHMARK(BM_NameLookupIndex)->Arg(64)->Arg(4096)->Arg(100000);
+
+// ===================================================
+//  Wczytywanie pliku
+// ===================================================
+
+// Punkt odniesienia: dawna pętla std::getline + splitParam + std::map<std::string>
+static void BM_LoadLegacyGetline(benchmark::State& state)
+{
+    WriteLoadFile("bench_load_legacy.cfg", state.range(0), kMaxLoadKeys);
+
+    std::map<std::string, int> names;
+    std::vector<ConfigParameter> params;
+    for (int i = 0; i < kMaxLoadKeys; ++i) {
+        names["key_" + std::to_string(i)] = i;
+        params.emplace_back("key_" + std::to_string(i), "d", "0");
+    }
+
+    for (auto _ : state) {
+        std::ifstream in("bench_load_legacy.cfg");
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            size_t delimiterPos = line.find_first_of('=');
+            std::pair<std::string, std::string> parameter{line.substr(0, delimiterPos), line.substr(delimiterPos + 1)};
+            auto it = names.find(parameter.first);
+            if (it == names.end()) {
+                continue;
+            }
+            params[it->second].set(parameter.second);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(std::filesystem::file_size("bench_load_legacy.cfg")));
+    std::remove("bench_load_legacy.cfg");
+}
+BENCHMARK(BM_LoadLegacyGetline)->Arg(1000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+// ===================================================
+//  Tokenizacja (bez przypisywania wartości)
+// ===================================================
+
+// Plik w formacie z sekcjami: nagłówek co 64 linie, spacje wokół `=`
+// i komentarze na końcu linii
+static void WriteSectionFile(const std::string& path, int64_t lines)
+{
+    std::ofstream out(path);
+    out << "# generated\n";
+    for (int64_t i = 0; i < lines; ++i) {
+        if (i % 64 == 0) {
+            out << "[section_" << i / 64 << "]\n";
+        }
+        out << "key_" << i % 64 << " = \"value " << i << "\"  # comment\n";
+    }
+}
+
+// Dawna ścieżka: std::getline i podział na pierwszym `=` do dwóch napisów
+static void BM_TokenizeLegacyGetline(benchmark::State& state)
+{
+    WriteLoadFile("bench_tokenize.cfg", state.range(0), kMaxLoadKeys);
+    for (auto _ : state) {
+        std::ifstream in("bench_tokenize.cfg");
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            size_t delimiterPos = line.find_first_of('=');
+            std::pair<std::string, std::string> parameter{line.substr(0, delimiterPos), line.substr(delimiterPos + 1)};
+            benchmark::DoNotOptimize(parameter);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(std::filesystem::file_size("bench_tokenize.cfg")));
+    std::remove("bench_tokenize.cfg");
+}
+BENCHMARK(BM_TokenizeLegacyGetline)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+// Strumieniowy tokenizer czytający plik kawałkami.
+// Argumenty: {liczba linii, 0 = płaskie `key=value`, 1 = sekcje i komentarze}
+static void BM_TokenizeFile(benchmark::State& state)
+{
+    if (state.range(1) == 0) {
+        WriteLoadFile("bench_tokenize.cfg", state.range(0), kMaxLoadKeys);
+    } else {
+        WriteSectionFile("bench_tokenize.cfg", state.range(0));
+    }
+    for (auto _ : state) {
+        parseFile("bench_tokenize.cfg", [](std::string_view name, std::string_view value) {
+            benchmark::DoNotOptimize(name);
+            benchmark::DoNotOptimize(value);
+        });
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(std::filesystem::file_size("bench_tokenize.cfg")));
+    std::remove("bench_tokenize.cfg");
+}
+BENCHMARK(BM_TokenizeFile)->ArgsProduct({{100000, 1000000}, {0, 1}})->Unit(benchmark::kMillisecond);
+
+// Wpływ rozmiaru kawałka na tokenizację tekstu z pamięci
+static void BM_TokenizeChunkSize(benchmark::State& state)
+{
+    WriteSectionFile("bench_tokenize.cfg", 100000);
+    std::string text;
+    {
+        std::ifstream in("bench_tokenize.cfg");
+        text.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    std::remove("bench_tokenize.cfg");
+
+    const size_t chunk = static_cast<size_t>(state.range(0));
+    auto sink          = [](std::string_view name, std::string_view value) {
+        benchmark::DoNotOptimize(name);
+        benchmark::DoNotOptimize(value);
+    };
+    IniTokenizer tokenizer;
+    for (auto _ : state) {
+        for (size_t pos = 0; pos < text.size(); pos += chunk) {
+            tokenizer.feed(std::string_view(text).substr(pos, chunk), sink);
+        }
+        tokenizer.finish(sink);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_TokenizeChunkSize)->Arg(256)->Arg(4096)->Arg(64 * 1024)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+// Przeładowanie, w którym zmienia się wartość każdego zarejestrowanego klucza:
+// plik konfiguracyjny jest dowiązaniem przełączanym między dwiema wersjami.
+// Argumenty: {liczba linii, liczba zarejestrowanych kluczy}
+static void BM_Reload(benchmark::State& state)
+{
+    const int64_t lines = state.range(0);
+    const int64_t keys  = state.range(1);
+    WriteLoadFile("bench_load_a.cfg", lines, keys, 0);
+    WriteLoadFile("bench_load_b.cfg", lines, keys, 1);
+    RegisterLoadParams(keys);
+
+    auto& cfg = LoadBenchConfig::instance();
+    bool flip = false;
+    for (auto _ : state) {
+        state.PauseTiming();
+        PointConfigAt(flip ? "bench_load_b.cfg" : "bench_load_a.cfg");
+        flip = !flip;
+        state.ResumeTiming();
+
+        cfg.loadFromFile();
+    }
+    state.SetItemsProcessed(state.iterations() * lines);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(std::filesystem::file_size("bench_load_a.cfg")));
+    std::remove("bench_load_config.cfg");
+    std::remove("bench_load_a.cfg");
+    std::remove("bench_load_b.cfg");
+}
+BENCHMARK(BM_Reload)->ArgsProduct({{1000, 100000, 1000000}, {64, kMaxLoadKeys}})->Unit(benchmark::kMillisecond);
+
+// Jak WriteLoadFile, ale obie wersje różnią się tylko ostatnią linią
+static void WriteOneKeyFile(const std::string& path, int64_t lines, int64_t keys, int64_t value)
+{
+    WriteLoadFile(path, lines, keys);
+    std::ofstream out(path, std::ios::app);
+    out << "key_0=" << value << "\n";
+}
+
+// Przeładowanie, w którym zmienia się jeden klucz: pełne loadFromFile()
+// albo przyrostowe reload(). Argumenty: {liczba linii, przyrostowo}
+static void BM_ReloadOneKey(benchmark::State& state)
+{
+    const int64_t lines = state.range(0);
+    WriteOneKeyFile("bench_load_a.cfg", lines, kMaxLoadKeys, 0);
+    WriteOneKeyFile("bench_load_b.cfg", lines, kMaxLoadKeys, 1);
+    RegisterLoadParams(kMaxLoadKeys);
+
+    auto& cfg = LoadBenchConfig::instance();
+    bool flip = false;
+    for (auto _ : state) {
+        state.PauseTiming();
+        PointConfigAt(flip ? "bench_load_b.cfg" : "bench_load_a.cfg");
+        flip = !flip;
+        state.ResumeTiming();
+
+        if (state.range(1) != 0) {
+            benchmark::DoNotOptimize(cfg.reload());
+        } else {
+            cfg.loadFromFile();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * lines);
+    std::remove("bench_load_config.cfg");
+    std::remove("bench_load_a.cfg");
+    std::remove("bench_load_b.cfg");
+}
+BENCHMARK(BM_ReloadOneKey)->ArgsProduct({{1000, 100000}, {0, 1}})->Unit(benchmark::kMicrosecond);
+
+// reload() niezmienionego pliku. Argument: 1 – stary plik, wystarczą rozmiar
+// i czas modyfikacji; 0 – świeży plik, rozstrzyga skrót treści
+static void BM_ReloadUnchanged(benchmark::State& state)
+{
+    const int64_t lines = 100000;
+    WriteLoadFile("bench_load_config.cfg", lines, kMaxLoadKeys);
+    if (state.range(0) != 0) {
+        std::filesystem::last_write_time("bench_load_config.cfg", std::filesystem::file_time_type::clock::now() - std::chrono::seconds(10));
+    }
+    RegisterLoadParams(kMaxLoadKeys);
+
+    auto& cfg = LoadBenchConfig::instance();
+    cfg.reload();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cfg.reload());
+    }
+    std::remove("bench_load_config.cfg");
+}
+BENCHMARK(BM_ReloadUnchanged)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+// Czas, przez który wywołujący jest zajęty przeładowaniem jednego klucza:
+// reload() na jego wątku albo samo zlecenie reloadAsync(). Argument: async
+static void BM_ReloadCaller(benchmark::State& state)
+{
+    const int64_t lines = 100000;
+    WriteOneKeyFile("bench_load_a.cfg", lines, kMaxLoadKeys, 0);
+    WriteOneKeyFile("bench_load_b.cfg", lines, kMaxLoadKeys, 1);
+    RegisterLoadParams(kMaxLoadKeys);
+
+    auto& cfg = LoadBenchConfig::instance();
+    bool flip = false;
+    for (auto _ : state) {
+        state.PauseTiming();
+        PointConfigAt(flip ? "bench_load_b.cfg" : "bench_load_a.cfg");
+        flip = !flip;
+        state.ResumeTiming();
+
+        if (state.range(0) != 0) {
+            auto pending = cfg.reloadAsync();
+            state.PauseTiming();
+            pending.get();
+            state.ResumeTiming();
+        } else {
+            benchmark::DoNotOptimize(cfg.reload());
+        }
+    }
+    std::remove("bench_load_config.cfg");
+    std::remove("bench_load_a.cfg");
+    std::remove("bench_load_b.cfg");
+}
+// stała liczba iteracji: przygotowanie pliku poza pomiarem trwa dłużej niż samo zlecenie
+BENCHMARK(BM_ReloadCaller)->Arg(0)->Arg(1)->Iterations(50)->Unit(benchmark::kMicrosecond);
+
+// Start procesu: parametry mają wartości domyślne, plik tekstowy bez cache
+static void BM_StartupText(benchmark::State& state)
+{
+    WriteLoadFile("bench_load_config.cfg", state.range(0), kMaxLoadKeys);
+
+    auto& cfg = LoadBenchConfig::instance();
+    for (auto _ : state) {
+        state.PauseTiming();
+        RegisterLoadParams(kMaxLoadKeys);
+        state.ResumeTiming();
+
+        cfg.loadFromFile();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    std::remove("bench_load_config.cfg");
+}
+BENCHMARK(BM_StartupText)->Arg(1000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+// Start procesu z gotowym binarnym cache (bench_load_config.cfg.bin)
+static void BM_StartupCached(benchmark::State& state)
+{
+    WriteLoadFile("bench_load_config.cfg", state.range(0), kMaxLoadKeys);
+    std::remove("bench_load_config.cfg.bin");
+
+    auto& cfg = LoadBenchConfig::instance();
+    RegisterLoadParams(kMaxLoadKeys);
+    cfg.loadFromFileCached();  // buduje cache
+    for (auto _ : state) {
+        state.PauseTiming();
+        RegisterLoadParams(kMaxLoadKeys);
+        state.ResumeTiming();
+
+        cfg.loadFromFileCached();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    std::remove("bench_load_config.cfg");
+    std::remove("bench_load_config.cfg.bin");
+}
+BENCHMARK(BM_StartupCached)->Arg(1000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+// ===================================================
+//  Instancje ze wspólnym schematem
+// ===================================================
+
+// Rejestracja `keys` parametrów: addParam() po kolei albo Schema::Builder
+static void BM_RegisterAddParam(benchmark::State& state)
+{
+    for (auto _ : state) {
+        RegisterLoadParams(state.range(0));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RegisterAddParam)->Arg(64)->Arg(kMaxLoadKeys)->Unit(benchmark::kMicrosecond);
+
+static void BM_RegisterSchema(benchmark::State& state)
+{
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(MakeLoadSchema(state.range(0)));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RegisterSchema)->Arg(64)->Arg(kMaxLoadKeys)->Unit(benchmark::kMicrosecond);
+
+// Utworzenie i wczytanie instancji najemcy dla gotowego schematu
+static void BM_TenantLoad(benchmark::State& state)
+{
+    auto schema = MakeLoadSchema(kMaxLoadKeys);
+    WriteLoadFile("bench_load_tenant.cfg", state.range(0), kMaxLoadKeys);
+    for (auto _ : state) {
+        LoadBenchConfig tenant(schema, "bench_load_tenant.cfg");
+        tenant.loadFromFile();
+        benchmark::DoNotOptimize(tenant.value<int>(LoadBenchParam{}));
+    }
+    state.SetItemsProcessed(state.iterations());
+    std::remove("bench_load_tenant.cfg");
+}
+BENCHMARK(BM_TenantLoad)->Arg(0)->Arg(100)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+// ===================================================
+//  Równoległe wczytywanie wielu plików
+// ===================================================
+
+// 1000 plików najemców po 100 linii i co setny duży (100 000 linii);
+// argument: liczba wątków puli
+static void BM_LoadBatch(benchmark::State& state)
+{
+    constexpr int kTenants = 1000;
+    auto schema            = MakeLoadSchema(kMaxLoadKeys);
+
+    std::vector<std::unique_ptr<LoadBenchConfig>> tenants;
+    std::vector<LoadJob<LoadBenchParam>> jobs;
+    for (int t = 0; t < kTenants; ++t) {
+        std::string path = "bench_load_tenant_" + std::to_string(t) + ".cfg";
+        WriteLoadFile(path, t % 100 == 0 ? 100000 : 100, kMaxLoadKeys, t);
+        tenants.push_back(std::make_unique<LoadBenchConfig>(schema, path));
+        jobs.push_back({tenants.back().get(), path});
+    }
+
+    WorkStealingPool pool(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(loadBatch(jobs, pool));
+    }
+    state.SetItemsProcessed(state.iterations() * kTenants);
+
+    for (const auto& job : jobs) {
+        std::remove(job.path.c_str());
+    }
+}
+BENCHMARK(BM_LoadBatch)->RangeMultiplier(2)->Range(1, 16)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// ===================================================
+//  Warstwy źródeł
+// ===================================================
+
+// Rozwiązanie `layers` plików po 1000 linii w jedną tabelę; odczyt po
+// wczytaniu pozostaje jednym wyszukiwaniem niezależnie od liczby warstw
+static void BM_LoadLayers(benchmark::State& state)
+{
+    auto schema = MakeLoadSchema(kMaxLoadKeys);
+    LoadBenchConfig cfg(schema, "bench_load_layers.cfg");
+
+    ConfigSources sources;
+    for (int64_t layer = 0; layer < state.range(0); ++layer) {
+        std::string path = "bench_load_layer_" + std::to_string(layer) + ".cfg";
+        WriteLoadFile(path, 1000, kMaxLoadKeys, layer);
+        sources.file(path);
+    }
+
+    for (auto _ : state) {
+        cfg.load(sources);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 1000);
+
+    for (const auto& layer : sources.layers()) {
+        std::remove(layer.name.c_str());
+    }
+}
+BENCHMARK(BM_LoadLayers)->Arg(1)->Arg(4)->Arg(16)->Unit(benchmark::kMicrosecond);
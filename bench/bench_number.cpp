@@ -0,0 +1,74 @@
+/*
+ * World VTT / cpp_config – benchmarki parametrów liczbowych
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <string>
+
+#include "ConfigNumber.h"
+#include "ConfigParameter.h"
+
+using namespace cpp_config;
+
+// Zwykły parametr typu Integer: strtoll i strtod przy każdym set()
+static void BM_IntegerSetLegacy(benchmark::State& state)
+{
+    ConfigParameter p("port", "TCP port", "80", ConfigValue::Type::Integer);
+    const std::string value = "65000";
+    for (auto _ : state) {
+        p.set(value);
+    }
+}
+BENCHMARK(BM_IntegerSetLegacy);
+
+static void BM_IntegerSet(benchmark::State& state)
+{
+    ConfigInteger p("port", "TCP port", "80", 1, 65535);
+    const std::string value = "65000";
+    for (auto _ : state) {
+        p.set(value);
+    }
+}
+BENCHMARK(BM_IntegerSet);
+
+static void BM_FloatSet(benchmark::State& state)
+{
+    ConfigFloat p("ratio", "Ratio", "0.5", 0.0, 1.0);
+    const std::string value = "0.125";
+    for (auto _ : state) {
+        p.set(value);
+    }
+}
+BENCHMARK(BM_FloatSet);
+
+static void BM_SizeSet(benchmark::State& state)
+{
+    ConfigSize p("cache", "Cache size", "1MiB");
+    const std::string value = "64MiB";
+    for (auto _ : state) {
+        p.set(value);
+    }
+}
+BENCHMARK(BM_SizeSet);
+
+static void BM_DurationSet(benchmark::State& state)
+{
+    ConfigDuration p("timeout", "Timeout", "1s");
+    const std::string value = "250ms";
+    for (auto _ : state) {
+        p.set(value);
+    }
+}
+BENCHMARK(BM_DurationSet);
+
+// Odczyt zapisanej wartości natywnej – bez parsowania
+static void BM_DurationRead(benchmark::State& state)
+{
+    ConfigDuration p("timeout", "Timeout", "250ms");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(p.as<std::chrono::milliseconds>());
+    }
+}
+BENCHMARK(BM_DurationRead);
@@ -0,0 +1,378 @@
+/*
+ * World VTT / cpp_config – benchmarki odczytu
+ *
+ * Opóźnienie odczytu dla każdego typu oraz przepustowość odczytów
+ * wielowątkowych.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "Config.h"
+#include "ConfigBinding.h"
+#include "ConfigParameter.h"
+#include "ConfigSchema.h"
+#include "ConfigShared.h"
+
+using namespace cpp_config;
+
+enum class ReadBenchParam
+{
+    Port,
+    Ratio,
+    Enabled,
+    Host,
+};
+
+using ReadBenchConfig = Config<ReadBenchParam>;
+
+enum class DenseReadBenchParam
+{
+    Port,
+    Ratio,
+    Enabled,
+    Host,
+    Count,
+};
+
+using DenseReadBenchConfig = Config<DenseReadBenchParam>;
+
+enum class ArenaReadBenchParam
+{
+    Port,
+    Ratio,
+    Enabled,
+    Host,
+    Count,
+};
+
+template <>
+struct cpp_config::ConfigArenaTraits<ArenaReadBenchParam> {
+        static constexpr bool enabled = true;
+};
+
+// Jak DenseReadBenchParam, ale z licznikami odczytów
+enum class StatsReadBenchParam
+{
+    Port,
+    Ratio,
+    Enabled,
+    Host,
+    Count,
+};
+
+template <>
+struct cpp_config::ConfigStatsTraits<StatsReadBenchParam> {
+        static constexpr bool enabled = true;
+};
+
+namespace cpp_config {
+template<>
+const std::string Config<ReadBenchParam>::_confFileName = "bench_read_config.cfg";
+template<>
+const std::string Config<DenseReadBenchParam>::_confFileName = "bench_dense_read_config.cfg";
+template<>
+const std::string Config<ArenaReadBenchParam>::_confFileName = "bench_arena_read_config.cfg";
+template<>
+const std::string Config<StatsReadBenchParam>::_confFileName = "bench_stats_read_config.cfg";
+}  // namespace cpp_config
+
+template <class Params>
+static Config<Params>& SetupConfig()
+{
+    auto& cfg = Config<Params>::instance();
+    cfg.clear();
+    cfg.addParam(Params::Port, std::make_shared<ConfigParameter>("port", "TCP port", "8080", ConfigValue::Type::Integer));
+    cfg.addParam(Params::Ratio, std::make_shared<ConfigParameter>("ratio", "Ratio", "0.75", ConfigValue::Type::Floating));
+    cfg.addParam(Params::Enabled, std::make_shared<ConfigParameter>("enabled", "Enabled", "true", ConfigValue::Type::Bool));
+    cfg.addParam(Params::Host, std::make_shared<ConfigParameter>("host", "Host", "localhost"));
+    return cfg;
+}
+
+// ===================================================
+//  Odczyt ConfigParameter::as<T>()
+// ===================================================
+
+// Punkt odniesienia: dawna ścieżka as<T>() parsowała tekst przy każdym odczycie
+static void BM_ParameterReparseInt(benchmark::State& state)
+{
+    ConfigParameter p("port", "TCP port", "8080");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(static_cast<int>(std::stoll(p.value())));
+    }
+}
+BENCHMARK(BM_ParameterReparseInt);
+
+static void BM_ParameterReparseDouble(benchmark::State& state)
+{
+    ConfigParameter p("ratio", "Ratio", "0.75");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::stod(p.value()));
+    }
+}
+BENCHMARK(BM_ParameterReparseDouble);
+
+// Przykładowy tekst parametru dla każdego typu odczytu
+template <typename T>
+static const char* SampleText()
+{
+    if constexpr (std::is_same_v<T, bool>) {
+        return "true";
+    } else if constexpr (std::is_floating_point_v<T>) {
+        return "0.75";
+    } else if constexpr (std::is_integral_v<T>) {
+        return "8080";
+    } else {
+        return "localhost";
+    }
+}
+
+template <typename T>
+static void BM_ParameterAs(benchmark::State& state)
+{
+    ConfigParameter p("param", "d", SampleText<T>());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(p.as<T>());
+    }
+}
+BENCHMARK_TEMPLATE(BM_ParameterAs, int);
+BENCHMARK_TEMPLATE(BM_ParameterAs, long long);
+BENCHMARK_TEMPLATE(BM_ParameterAs, double);
+BENCHMARK_TEMPLATE(BM_ParameterAs, float);
+BENCHMARK_TEMPLATE(BM_ParameterAs, bool);
+BENCHMARK_TEMPLATE(BM_ParameterAs, std::string);
+
+// ===================================================
+//  Odczyt Config<Enum>::value<T>()
+// ===================================================
+
+// Oba słowniki mają te same nazwy kluczy; typ odczytu wybiera parametr
+template <class Params, typename T>
+static constexpr Params SampleKey()
+{
+    if constexpr (std::is_same_v<T, bool>) {
+        return Params::Enabled;
+    } else if constexpr (std::is_floating_point_v<T>) {
+        return Params::Ratio;
+    } else if constexpr (std::is_integral_v<T>) {
+        return Params::Port;
+    } else {
+        return Params::Host;
+    }
+}
+
+template <class Params, typename T>
+static void BM_ConfigValue(benchmark::State& state)
+{
+    auto& cfg = SetupConfig<Params>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cfg.template value<T>(SampleKey<Params, T>()));
+    }
+}
+BENCHMARK_TEMPLATE(BM_ConfigValue, ReadBenchParam, int);
+BENCHMARK_TEMPLATE(BM_ConfigValue, ReadBenchParam, double);
+BENCHMARK_TEMPLATE(BM_ConfigValue, ReadBenchParam, bool);
+BENCHMARK_TEMPLATE(BM_ConfigValue, ReadBenchParam, std::string);
+BENCHMARK_TEMPLATE(BM_ConfigValue, DenseReadBenchParam, int);
+BENCHMARK_TEMPLATE(BM_ConfigValue, DenseReadBenchParam, double);
+BENCHMARK_TEMPLATE(BM_ConfigValue, DenseReadBenchParam, bool);
+BENCHMARK_TEMPLATE(BM_ConfigValue, DenseReadBenchParam, std::string);
+BENCHMARK_TEMPLATE(BM_ConfigValue, ArenaReadBenchParam, int);
+BENCHMARK_TEMPLATE(BM_ConfigValue, ArenaReadBenchParam, std::string);
+BENCHMARK_TEMPLATE(BM_ConfigValue, StatsReadBenchParam, int);
+BENCHMARK_TEMPLATE(BM_ConfigValue, StatsReadBenchParam, std::string);
+
+// get() kopiuje shared_ptr parametru albo, w trybie areny, migawki (licznik atomowy)
+template <class Params>
+static void BM_ConfigGet(benchmark::State& state)
+{
+    auto& cfg = SetupConfig<Params>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cfg.get(Params::Port)->template as<int>());
+    }
+}
+BENCHMARK_TEMPLATE(BM_ConfigGet, DenseReadBenchParam);
+BENCHMARK_TEMPLATE(BM_ConfigGet, ArenaReadBenchParam);
+BENCHMARK_TEMPLATE(BM_ConfigGet, StatsReadBenchParam);
+
+template <class Params>
+static void BM_ConfigGetThreads(benchmark::State& state)
+{
+    static auto& cfg = SetupConfig<Params>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cfg.get(Params::Port)->template as<int>());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_ConfigGetThreads, DenseReadBenchParam)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ConfigGetThreads, ArenaReadBenchParam)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ConfigGetThreads, StatsReadBenchParam)->ThreadRange(1, 16)->UseRealTime();
+
+// Uchwyt sprawdza tylko numer generacji i zwraca zapamiętaną wartość
+template <class Params, typename T>
+static void BM_ValueHandle(benchmark::State& state)
+{
+    auto& cfg   = SetupConfig<Params>();
+    auto handle = cfg.template handle<T>(SampleKey<Params, T>());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(handle.get());
+    }
+}
+BENCHMARK_TEMPLATE(BM_ValueHandle, DenseReadBenchParam, int);
+BENCHMARK_TEMPLATE(BM_ValueHandle, DenseReadBenchParam, std::string);
+BENCHMARK_TEMPLATE(BM_ValueHandle, ReadBenchParam, int);
+
+// Każdy wątek ma własną kopię uchwytu
+static void BM_ValueHandleThreads(benchmark::State& state)
+{
+    static auto& cfg = SetupConfig<DenseReadBenchParam>();
+    auto handle      = cfg.handle<int>(DenseReadBenchParam::Port);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(handle.get());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ValueHandleThreads)->ThreadRange(1, 16)->UseRealTime();
+
+struct ReadBenchTuning
+{
+    int port;
+    double ratio;
+    bool enabled;
+};
+
+// Trzy pola przez value<T>() – punkt odniesienia dla wiązania ze strukturą
+static void BM_ConfigValueThreeFields(benchmark::State& state)
+{
+    auto& cfg = SetupConfig<DenseReadBenchParam>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cfg.value<int>(DenseReadBenchParam::Port));
+        benchmark::DoNotOptimize(cfg.value<double>(DenseReadBenchParam::Ratio));
+        benchmark::DoNotOptimize(cfg.value<bool>(DenseReadBenchParam::Enabled));
+    }
+}
+BENCHMARK(BM_ConfigValueThreeFields);
+
+static void BM_BindingThreeFields(benchmark::State& state)
+{
+    auto& cfg = SetupConfig<DenseReadBenchParam>();
+    ConfigBinding<DenseReadBenchParam, ReadBenchTuning> binding(cfg);
+    binding.bind(&ReadBenchTuning::port, DenseReadBenchParam::Port)
+        .bind(&ReadBenchTuning::ratio, DenseReadBenchParam::Ratio)
+        .bind(&ReadBenchTuning::enabled, DenseReadBenchParam::Enabled);
+    auto reader = binding.reader();
+    for (auto _ : state) {
+        const ReadBenchTuning& tuning = reader.get();
+        benchmark::DoNotOptimize(tuning.port);
+        benchmark::DoNotOptimize(tuning.ratio);
+        benchmark::DoNotOptimize(tuning.enabled);
+    }
+}
+BENCHMARK(BM_BindingThreeFields);
+
+// Koszt set() razem z budową nowej kopii struktury w wywołaniu zwrotnym
+static void BM_BindingMaterialize(benchmark::State& state)
+{
+    auto& cfg = SetupConfig<DenseReadBenchParam>();
+    ConfigBinding<DenseReadBenchParam, ReadBenchTuning> binding(cfg);
+    binding.bind(&ReadBenchTuning::port, DenseReadBenchParam::Port)
+        .bind(&ReadBenchTuning::ratio, DenseReadBenchParam::Ratio)
+        .bind(&ReadBenchTuning::enabled, DenseReadBenchParam::Enabled);
+    int port = 0;
+    for (auto _ : state) {
+        cfg.set(DenseReadBenchParam::Port, std::to_string(++port % 1000));
+    }
+}
+BENCHMARK(BM_BindingMaterialize);
+
+// Odczyt z pamięci współdzielonej: kopia slotu pod seqlockiem, bez wywołań systemowych
+template <typename T>
+static void BM_SharedReaderValue(benchmark::State& state)
+{
+    auto& cfg = SetupConfig<DenseReadBenchParam>();
+    SharedConfigPublisher<DenseReadBenchParam> publisher(cfg, "/cpp_config_bench_read");
+    SharedConfigReader<DenseReadBenchParam> reader(cfg.schema(), publisher.name());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(reader.value<T>(SampleKey<DenseReadBenchParam, T>()));
+    }
+}
+BENCHMARK_TEMPLATE(BM_SharedReaderValue, int);
+BENCHMARK_TEMPLATE(BM_SharedReaderValue, std::string);
+
+// Koszt publikacji całej tabeli po zmianie konfiguracji
+static void BM_SharedPublish(benchmark::State& state)
+{
+    auto& cfg = SetupConfig<DenseReadBenchParam>();
+    SharedConfigPublisher<DenseReadBenchParam> publisher(cfg, "/cpp_config_bench_publish");
+    int port = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        cfg.set(DenseReadBenchParam::Port, std::to_string(++port % 1000));
+        state.ResumeTiming();
+        publisher.publish();
+    }
+}
+BENCHMARK(BM_SharedPublish);
+
+static void BM_SnapshotValueInt(benchmark::State& state)
+{
+    auto& cfg     = SetupConfig<DenseReadBenchParam>();
+    auto snapshot = cfg.snapshot();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(snapshot->value<int>(DenseReadBenchParam::Port));
+    }
+}
+BENCHMARK(BM_SnapshotValueInt);
+
+// Wszystkie wątki czytają ten sam, raz skonfigurowany singleton
+static void BM_ConfigValueIntThreads(benchmark::State& state)
+{
+    static auto& cfg = SetupConfig<DenseReadBenchParam>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cfg.value<int>(DenseReadBenchParam::Port));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConfigValueIntThreads)->ThreadRange(1, 16)->UseRealTime();
+
+// ===================================================
+//  Schemat czasu kompilacji (StaticConfig)
+// ===================================================
+
+enum class StaticBenchParam
+{
+    Port,
+};
+
+template <>
+struct cpp_config::ParamTraits<StaticBenchParam::Port> {
+        using type = int;
+        static constexpr std::string_view name        = "port";
+        static constexpr std::string_view description = "TCP port";
+        static constexpr int defaultValue             = 8080;
+};
+
+using StaticBenchConfig = StaticConfig<StaticBenchParam, StaticBenchParam::Port>;
+
+static void BM_StaticConfigGet(benchmark::State& state)
+{
+    StaticBenchConfig cfg("bench_static_config.cfg");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cfg.get<StaticBenchParam::Port>());
+    }
+}
+BENCHMARK(BM_StaticConfigGet);
+
+static void BM_StaticSnapshotGet(benchmark::State& state)
+{
+    StaticBenchConfig cfg("bench_static_config.cfg");
+    auto snapshot = cfg.snapshot();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(snapshot->get<StaticBenchParam::Port>());
+    }
+}
+BENCHMARK(BM_StaticSnapshotGet);
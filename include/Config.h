@@ -14,15 +14,40 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
 #include <exception>
-#include <fstream>
+#include <functional>
+#include <future>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <typeinfo>
 #include <utility>
+#include <vector>
 
+#include "ConfigArena.h"
+#include "ConfigCache.h"
 #include "ConfigChoice.h"
+#include "ConfigExceptions.h"
+#include "ConfigFile.h"
+#include "ConfigNameIndex.h"
 #include "ConfigParameter.h"
+#include "ConfigParser.h"
+#include "ConfigReport.h"
+#include "ConfigSnapshot.h"
+#include "ConfigSources.h"
+#include "ConfigStats.h"
+#include "ConfigStorage.h"
+#include "ConfigThreadPool.h"
+#include "ConfigWatcher.h"
 
 namespace cpp_config {
     template <class ParamsDict>
@@ -32,80 +57,1406 @@ namespace cpp_config {
             class ParameterNotRegistered : std::exception {};
             class ConfigurationFileError : std::exception {};
 
+            using Snapshot       = ConfigSnapshot<ParamsDict>;
+            using Handle         = typename Snapshot::Handle;
+            using Names          = NameIndex<ParamsDict>;
+            using ChangeCallback = std::function<void(const ConfigParameter &previous, const ConfigParameter &current)>;
+            using ErrorCallback  = std::function<void(std::exception_ptr error)>;
+            using CheckCallback  = std::function<void(const ConfigParameter &candidate)>;
+
+            static constexpr bool Arena = ConfigArenaTraits<ParamsDict>::enabled;
+            static constexpr bool Stats = ConfigStatsTraits<ParamsDict>::enabled;
+
+            /*
+             * Registered parameters with their defaults, the name index and
+             * the schema fingerprint.
+             *
+             * Immutable once built, so any number of Config instances can share
+             * one schema: each instance only owns the values that differ from
+             * the defaults. Built with a Builder, or implicitly by addParam().
+             */
+            class Schema : public std::enable_shared_from_this<Schema> {
+                public:
+                    using Params = ConfigStorage<ParamsDict, std::shared_ptr<const ConfigParameter>>;
+                    using Map    = std::map<std::string, ParamsDict, std::less<>>;
+
+                    class Builder {
+                        public:
+                            Builder() = default;
+                            explicit Builder(const Schema &schema) : _params(schema._params), _names(schema._names) {
+                            }
+
+                            Builder &add(const ParamsDict &key, std::shared_ptr<ConfigParameter> param) {
+                                if (_params.contains(key)) {
+                                    throw ParameterAlreadyRegistered();
+                                }
+                                _names[param->name()] = key;
+                                _params.insert(key, std::move(param));
+                                return *this;
+                            }
+
+                            std::shared_ptr<const Schema> build() const {
+                                return std::make_shared<const Schema>(_params, _names);
+                            }
+
+                        protected:
+                            //
+                        private:
+                            Params _params;
+                            Map _names;
+                    };
+
+                    Schema(Params params, Map names) : _params(std::move(params)), _names(std::move(names)), _index(_names), _hash(HashSeed) {
+                        _hash = hashCombine(_hash, std::to_string(BinaryCache::Version));
+                        _params.forEach([this](const ParamsDict &key, const std::shared_ptr<const ConfigParameter> &param) {
+                            _hash = hashCombine(_hash, std::to_string(static_cast<std::int64_t>(key)));
+                            _hash = hashCombine(_hash, param->name());
+                            _hash = hashCombine(_hash, toString(param->type()));
+                            // several parameter classes share one type, e.g. ConfigSize and ConfigInteger
+                            const ConfigParameter &parameter = *param;
+                            _hash                            = hashCombine(_hash, typeid(parameter).name());
+                            _hash = hashCombine(_hash, param->description());
+                        });
+                    }
+
+                    const Params &params() const {
+                        return _params;
+                    }
+
+                    const Names &names() const {
+                        return _index;
+                    }
+
+                    // Fingerprint of the registered names, types, parameter
+                    // classes and descriptions.
+                    std::uint64_t hash() const {
+                        return _hash;
+                    }
+
+                protected:
+                    //
+                private:
+                    Params _params;
+                    Map _names;
+                    Names _index;
+                    std::uint64_t _hash;
+            };
+
+            /*
+             * Typed view of one parameter for tight loops, see handle().
+             *
+             * Keeps a copy of the value together with the generation of the
+             * snapshot it was read from. get() compares that generation with
+             * the published one, a single atomic load, and reads the
+             * value again only after a reload or set(). A handle is not
+             * thread-safe: every thread keeps its own copy, which then acts as
+             * that thread's cache. It must not outlive the Config.
+             */
+            template <typename T>
+            class ValueHandle {
+                public:
+                    ValueHandle(const Config &config, const ParamsDict &key) : _config(&config), _key(key), _generation(0) {
+                        refresh();
+                    }
+
+                    const T &get() {
+                        if (_config->generation() != _generation) [[unlikely]] {
+                            refresh();
+                        }
+                        return _value;
+                    }
+
+                    const ParamsDict &key() const {
+                        return _key;
+                    }
+
+                protected:
+                    //
+                private:
+                    const Config *_config;
+                    ParamsDict _key;
+                    std::uint64_t _generation;
+                    T _value;
+
+                    void refresh() {
+                        std::shared_ptr<const Snapshot> snapshot = _config->snapshot();
+                        _value                                   = snapshot->template value<T>(_key);
+                        _generation                              = snapshot->generation();
+                    }
+            };
+
+            // Outcome of reload().
+            struct ReloadResult {
+                    bool skipped   = false;           // the file was not parsed at all
+                    bool cancelled = false;           // reloadAsync() superseded by a newer one, nothing applied
+                    std::vector<ParamsDict> changed;  // keys whose value changed, in key order
+            };
+
+            // What `co_await config.awaitReload()` waits for; see reloadAsync().
+            class ReloadAwaiter {
+                public:
+                    explicit ReloadAwaiter(Config &config) : _config(config) {
+                    }
+
+                    bool await_ready() const noexcept {
+                        return false;
+                    }
+
+                    void await_suspend(std::coroutine_handle<> coroutine) {
+                        _config.postReload([this, coroutine](ReloadResult result, std::exception_ptr error) {
+                            _result = std::move(result);
+                            _error  = std::move(error);
+                            coroutine.resume();
+                        });
+                    }
+
+                    ReloadResult await_resume() {
+                        if (_error) {
+                            std::rethrow_exception(_error);
+                        }
+                        return std::move(_result);
+                    }
+
+                protected:
+                    //
+                private:
+                    Config &_config;
+                    ReloadResult _result;
+                    std::exception_ptr _error;
+            };
+
             static Config<ParamsDict> &instance() {  // cppcheck-suppress unusedFunction
                 static Config<ParamsDict> instance;
                 return instance;
             }
+
+            // Independent configuration read from `path`. Instances created from
+            // the same schema share the registered parameters and name index and
+            // can be loaded concurrently with each other.
+            Config(std::shared_ptr<const Schema> schema, std::string path)
+                : _path(std::move(path)),
+                  _arena(Arena ? std::make_shared<ParameterArena>() : nullptr),
+                  _snapshot(std::make_shared<const Snapshot>(adoptAll(*schema), defaultSources(*schema), 0, _arena)),
+                  _generation(0),
+                  _schema(schema),
+                  _schemas(std::move(schema)),
+                  _schemaDirty(false) {
+                if constexpr (Arena) {
+                    _arena->published(0, _snapshot.load(), {}, {});
+                }
+                if constexpr (Stats) {
+                    _stats.track(_schema->params());
+                }
+            }
+            ~Config() {
+                stopWatching();
+                // requests still queued end as cancelled, without reading the file
+                _reloadTicket.fetch_add(1, std::memory_order_acq_rel);
+                _reloader.reset();
+                _saver.reset();
+            }
+
+            // Registers a parameter on this instance. An instance created from a
+            // shared schema gets its own copy of it on the first call.
+            // Registrations are only collected here; they are published
+            // together by freeze(), which the first read or load calls.
             void addParam(const ParamsDict &key,
                           std::shared_ptr<ConfigParameter> param) {  // cppcheck-suppress unusedFunction
-                if (_paramCollection.find(key) != _paramCollection.end()) {
-                    throw ParameterAlreadyRegistered();
+                std::lock_guard<std::mutex> lock(_loadMutex);
+                if (!_registration) {
+                    _registration = std::make_unique<typename Schema::Builder>(*_schema);
                 }
-
-                _paramCollection[key]        = param;
-                _params2enums[param->name()] = key;
+                _registration->add(key, std::move(param));
+                _schemaDirty.store(true, std::memory_order_release);
             }
 
-            const std::shared_ptr<ConfigParameter> get(const ParamsDict &key) const {
-                return _paramCollection.at(key);
+            // Shared ownership of the current parameter. With ConfigArenaTraits
+            // enabled the parameter lives in the arena and the returned
+            // ParameterRef shares ownership of the snapshot holding it
+            // instead, which keeps it valid across reloads, compact() and
+            // clear() for as long as the ParameterRef is held.
+            std::conditional_t<Arena, ParameterRef<ParamsDict>, std::shared_ptr<const ConfigParameter>> get(const ParamsDict &key) const {
+                freeze();
+                if constexpr (Stats) {
+                    _stats.countRead(key);
+                }
+                if constexpr (Arena) {
+                    std::shared_ptr<const Snapshot> snapshot = _snapshot.load();
+                    const ConfigParameter &param             = *snapshot->get(key);
+                    return ParameterRef<ParamsDict>(std::move(snapshot), param);
+                } else {
+                    return _snapshot.read([&key](const Snapshot &snapshot) { return snapshot.get(key); });
+                }
             }
 
             template <typename T>
             T value(const ParamsDict &key) const {
-                return get(key)->template as<T>();
+                freeze();
+                if constexpr (Stats) {
+                    _stats.countRead(key);
+                }
+                return _snapshot.read([&key](const Snapshot &snapshot) { return snapshot.template value<T>(key); });
             }
 
+            // Where the current value of `key` came from. Kept apart from the
+            // values, so it costs nothing on the read path.
+            ValueSource source(const ParamsDict &key) const {
+                freeze();
+                return _snapshot.read([&key](const Snapshot &snapshot) { return snapshot.source(key); });
+            }
+
+            std::optional<ParamsDict> findByName(std::string_view name) const {
+                freeze();
+                return _schemas.read([name](const Schema &schema) -> std::optional<ParamsDict> {
+                    const ParamsDict *key = schema.names().find(name);
+                    return key != nullptr ? std::optional<ParamsDict>(*key) : std::nullopt;
+                });
+            }
+
+            // Builds the schema, and with it the frozen name index used by
+            // loadFromFile() and findByName(), and publishes the parameters
+            // registered since the last call in one snapshot. Reads and loads
+            // call it on demand after addParam(); calling it once registration
+            // is done keeps that cost off the first lookup.
+            void freeze() const {
+                if (!_schemaDirty.load(std::memory_order_acquire)) {
+                    return;
+                }
+                std::lock_guard<std::mutex> lock(_loadMutex);
+                freezeLocked();
+            }
+
+            std::shared_ptr<const Schema> schema() const {
+                freeze();
+                return _schemas.load();
+            }
+
+            const std::string &path() const {
+                return _path;
+            }
+
+            // Binds to `key` once; reads through the handle skip the lookup and
+            // conversion until the configuration changes. Throws like
+            // value<T>() if the key is not registered or the type does not fit.
+            template <typename T>
+            ValueHandle<T> handle(const ParamsDict &key) const {
+                return ValueHandle<T>(*this, key);
+            }
+
+            // Generation of the published snapshot; grows with every reload,
+            // set() and freeze() of new registrations.
+            std::uint64_t generation() const {
+                freeze();
+                return _generation.load(std::memory_order_acquire);
+            }
+
+            // Consistent view of all parameters; stays valid across reloads.
+            std::shared_ptr<const Snapshot> snapshot() const {
+                freeze();
+                return _snapshot.load();
+            }
+
+            // Changes a single parameter at run time; publishes a new snapshot
+            // and fires the change callbacks like a reload does.
+            void set(const ParamsDict &key, const std::string &val) {
+                std::vector<Change> changes;
+                {
+                    std::lock_guard<std::mutex> lock(_loadMutex);
+                    freezeLocked();
+                    std::shared_ptr<const Snapshot> current = _snapshot.load();
+                    typename Snapshot::Storage params       = current->params();
+                    const Handle &previous                  = params.at(key);
+                    if (previous->value() == val) {
+                        return;
+                    }
+                    Handle updated = update(key, *previous, val);
+                    changes.push_back({key, previous, updated, current});
+                    params.insert(key, std::move(updated));
+                    typename Snapshot::Sources sources = current->sources();
+                    sources.insert(key, ValueSource::runtime());
+                    publish(std::move(params), std::move(sources));
+                }
+                notify(changes);
+            }
+
+            // Writes every parameter, preceded by its description as a comment,
+            // to the configuration file. The file is replaced atomically.
             void saveToFile() {  // cppcheck-suppress unusedFunction
-                std::ofstream out(_confFileName);
-                out.close();
+                // before _saveMutex: snapshot() may take _loadMutex, and the
+                // loads take _saveMutex while holding it
+                std::shared_ptr<const Snapshot> snapshot = this->snapshot();
+                writeSnapshot(*snapshot);
+            }
+
+            // Same as saveToFile(), but the write and fsync run on a background
+            // thread of this Config; the caller only captures the current
+            // snapshot. Saves run one at a time, in call order, and errors are
+            // reported through the future. Dropping the future does not wait;
+            // the destructor of Config waits for the saves still queued.
+            [[nodiscard]] std::future<void> saveToFileAsync() {  // cppcheck-suppress unusedFunction
+                auto promise                             = std::make_shared<std::promise<void>>();
+                std::future<void> future                 = promise->get_future();
+                std::shared_ptr<const Snapshot> snapshot = this->snapshot();
+                std::lock_guard<std::mutex> lock(_saverMutex);
+                if (!_saver) {
+                    _saver = std::make_unique<SerialExecutor>();
+                }
+                _saver->post([this, promise, snapshot]() {
+                    try {
+                        writeSnapshot(*snapshot);
+                        promise->set_value();
+                    } catch (...) {
+                        promise->set_exception(std::current_exception());
+                    }
+                });
+                return future;
+            }
+
+            static std::string serialize(const Snapshot &snapshot) {
+                std::string out;
+                snapshot.params().forEach([&out](const ParamsDict &, const Handle &param) {
+                    const std::string &description = param->description();
+                    std::size_t pos                 = 0;
+                    while (pos < description.size()) {
+                        std::size_t eol = description.find('\n', pos);
+                        if (eol == std::string::npos) {
+                            eol = description.size();
+                        }
+                        out.append("# ").append(description, pos, eol - pos).append("\n");
+                        pos = eol + 1;
+                    }
+                    out.append(param->name()).append("=");
+                    appendValue(out, param->value());
+                    out.append("\n\n");
+                });
+                return out;
             }
 
+            // Builds a new snapshot from the file and publishes it atomically;
+            // readers keep seeing the previous one until then. If a value is
+            // rejected nothing is published. Change callbacks run afterwards,
+            // on the calling thread, for the keys whose value changed.
             void loadFromFile() {
-                std::ifstream in(_confFileName);
-                if (!in.is_open()) {
-                    saveToFile();
-                    // throw ConfigurationFileError();
+                loadFile(_path, true);
+            }
+
+            // Same as loadFromFile(), but reads `path` instead of the instance
+            // file, and a missing file is an error rather than being created.
+            void loadFromFile(const std::string &path) {
+                loadFile(path, false);
+            }
+
+            // Like loadFromFile(), but reports every problem in the file in
+            // the same pass: malformed lines, unknown keys, rejected values
+            // and earlier values of duplicated keys, each with line and
+            // column. In Lenient mode rejected
+            // values keep their previous value and the rest is applied. In
+            // Strict mode any malformed line or rejected value leaves the
+            // configuration untouched and throws ConfigLoadError carrying the
+            // report. Unknown and duplicated keys are only reported.
+            LoadReport loadFromFile(LoadMode mode) {
+                LoadReport report;
+                loadFile(_path, true, Diagnostics{_path, mode, report, {}});
+                return report;
+            }
+
+            LoadReport loadFromFile(const std::string &path, LoadMode mode) {
+                LoadReport report;
+                loadFile(path, false, Diagnostics{path, mode, report, {}});
+                return report;
+            }
+
+            // Resolves the built-in defaults and every layer of `sources` into
+            // one table and publishes it, so reads stay a single lookup however
+            // many layers there are. Later layers win; keys that no layer sets
+            // go back to their default. A rejected value or a missing required
+            // file rejects the whole load.
+            void load(const ConfigSources &sources) {
+                std::vector<Change> changes;
+                {
+                    std::lock_guard<std::mutex> lock(_loadMutex);
+                    typename StatsCounters::ReloadTimer timer(_stats);
+                    freezeLocked();
+                    const Schema &schema = *_schema;
+                    const Names &names   = schema.names();
+
+                    Staged staged;
+                    staged.pin(_schema);
+                    typename Snapshot::Sources origins = defaultSources(schema);
+                    schema.params().forEach([&staged](const ParamsDict &key, const std::shared_ptr<const ConfigParameter> &param) {
+                        staged.refer(key, param->value());
+                    });
+
+                    for (const auto &layer : sources.layers()) {
+                        switch (layer.kind) {
+                            case ValueSource::Kind::File: {
+                                auto source = std::make_shared<const ValueSource>(ValueSource{layer.kind, layer.name});
+                                IniTokenizer tokenizer;
+                                bool opened = parseFile(
+                                    layer.name, tokenizer,
+                                    [&](std::string_view name, std::string_view value) {
+                                        const ParamsDict *key = names.find(name);
+                                        if (key != nullptr) {
+                                            staged.insert(*key, std::string(value));
+                                            origins.insert(*key, source);
+                                        } else if constexpr (Stats) {
+                                            _stats.countUnknown();
+                                        }
+                                    },
+                                    [this]() {
+                                        if constexpr (Stats) {
+                                            _stats.countMalformed();
+                                        }
+                                    });
+                                if (!opened && !layer.optional) {
+                                    throw ConfigurationError("Cannot open configuration file `" + layer.name + "`");
+                                }
+                                break;
+                            }
+                            case ValueSource::Kind::Environment:
+                                schema.params().forEach([&](const ParamsDict &key, const std::shared_ptr<const ConfigParameter> &param) {
+                                    std::string variable = ConfigSources::environmentName(layer.name, param->name());
+                                    if (const char *value = std::getenv(variable.c_str())) {
+                                        staged.insert(key, value);
+                                        origins.insert(key, std::make_shared<const ValueSource>(ValueSource{layer.kind, std::move(variable)}));
+                                    }
+                                });
+                                break;
+                            case ValueSource::Kind::CommandLine: {
+                                // a flag never takes the next argument as its value
+                                auto takesValue = [&schema, &names](std::string_view name) {
+                                    const ParamsDict *key = names.find(name);
+                                    return key != nullptr && schema.params().at(*key)->type() != ConfigValue::Type::Bool;
+                                };
+                                for (const auto &[name, value] : ConfigSources::options(layer, takesValue)) {
+                                    const ParamsDict *key = names.find(name);
+                                    if (key != nullptr) {
+                                        staged.insert(*key, value);
+                                        origins.insert(*key, std::make_shared<const ValueSource>(ValueSource{layer.kind, "--" + name}));
+                                    }
+                                }
+                                break;
+                            }
+                            default:
+                                break;
+                        }
+                    }
+                    apply(staged, std::move(origins), changes);
                 }
-                std::string line;
-                while (std::getline(in, line)) {
-                    if (line.empty() || line[0] == '#') {
-                        continue;
+                notify(changes);
+            }
+
+            // Like loadFromFile(), but goes through a binary cache next to the
+            // file (`<file>.bin`) holding the parsed values, which are taken
+            // over without parsing them again. The cache is used when it was
+            // built for the same registered schema and either from a file of
+            // the same size and modification time that had settled
+            // (SourceStamp::settled()), or from text of the same content hash;
+            // otherwise the text is parsed and the cache rewritten.
+            void loadFromFileCached() {  // cppcheck-suppress unusedFunction
+                std::vector<Change> changes;
+                {
+                    std::lock_guard<std::mutex> lock(_loadMutex);
+                    typename StatsCounters::ReloadTimer timer(_stats);
+                    freezeLocked();
+                    const std::string cachePath = _path + ".bin";
+                    const std::uint64_t hash    = _schema->hash();
+                    const SourceStamp source    = SourceStamp::of(_path);
+
+                    BinaryCache cache(cachePath, hash);
+                    bool fresh           = cache.builtFrom(source);
+                    std::uint64_t content = 0;
+                    if (!fresh && source.exists) {
+                        MappedFile file(_path);
+                        if (file.is_open()) {
+                            content = hashContent(file.content());
+                            fresh   = cache.builtFrom(content);
+                        }
                     }
-                    std::pair<std::string, std::string> parameter = splitParam(line, '=');
 
-                    if (parameter.first.empty()) {
-                        continue;
+                    if (fresh) {
+                        applyCached(cache, changes);
+                        if (!cache.builtFrom(source) && source.settled()) {
+                            // record the stamp, so the next start skips hashing
+                            writeCache(cachePath, hash, source, content, cache.entries());
+                        }
+                    } else {
+                        Staged staged;
+                        if (!stage(_path, staged)) {
+                            writeMissing();
+                        }
+                        apply(staged, sourcesFrom(staged, _path), changes);
+
+                        std::shared_ptr<const Snapshot> applied = _snapshot.load();
+                        std::vector<BinaryCache::Entry> entries;
+                        staged.forEach([&entries, &applied](const ParamsDict &key, const std::string &) {
+                            const Handle &param = applied->params().at(key);
+                            entries.push_back({static_cast<std::int64_t>(key), param->value(), param->parsed().parsed()});
+                        });
+                        if (source.exists) {
+                            writeCache(cachePath, hash, source, content, entries);
+                        }
                     }
+                }
+                notify(changes);
+            }
 
-                    auto it = _params2enums.find(parameter.first);
-                    if (it == _params2enums.end()) {
-                        continue;
+            /*
+             * Incremental loadFromFile(): ends with the same values, but only
+             * applies the entries that changed since the previous reload().
+             *
+             * The file is skipped when its size and modification time, or
+             * else its content hash, match the previous reload; size and
+             * time are only trusted for files last modified a few seconds
+             * before that reload (SourceStamp::settled()). Otherwise it
+             * is tokenized and each value is hashed; only values whose hash
+             * differs from the previous reload are validated and set. When
+             * nothing changed no snapshot is published, so value handles and
+             * bindings stay valid. The hashes describe the configuration
+             * published by the last reload(); after set(), load() or any other
+             * publication the next reload() applies the whole file again.
+             */
+            ReloadResult reload() {
+                ReloadResult result;
+                std::vector<Change> changes;
+                {
+                    std::lock_guard<std::mutex> lock(_loadMutex);
+                    typename StatsCounters::ReloadTimer timer(_stats);
+                    freezeLocked();
+                    const bool incremental = _reloadState && _reloadState->generation == _snapshot.load()->generation();
+                    const SourceStamp stamp = SourceStamp::of(_path);
+                    if (!stamp.exists) {
+                        _reloadState.reset();
+                        loadFileLocked(_path, true, changes, nullptr);
+                    } else if (incremental && stamp == _reloadState->stamp) {
+                        result.skipped = true;
+                        return result;
+                    } else {
+                        MappedFile file(_path);
+                        if (!file.is_open()) {
+                            throw ConfigurationError("Cannot open configuration file `" + _path + "`");
+                        }
+                        const std::uint64_t content = hashContent(file.content());
+                        if (incremental && content == _reloadState->content) {
+                            _reloadState->stamp = stamp.settled() ? stamp : SourceStamp{};
+                            result.skipped      = true;
+                            return result;
+                        }
+
+                        ReloadState next{stamp.settled() ? stamp : SourceStamp{}, content, 0, {}};
+                        Staged staged = stageChanged(_schema->names(), file.content(), incremental ? &_reloadState->values : nullptr, next.values);
+                        if (!incremental || !staged.empty()) {
+                            apply(staged, sourcesFrom(staged, _path), changes);
+                        }
+                        next.generation = _snapshot.load()->generation();
+                        _reloadState    = std::move(next);
                     }
-                    ParamsDict key = _params2enums[parameter.first];
-                    _paramCollection.at(key)->set(parameter.second);
                 }
-                in.close();
+                for (const auto &change : changes) {
+                    result.changed.push_back(change.key);
+                }
+                notify(changes);
+                return result;
+            }
+
+            /*
+             * reload() on a background thread, for callers that must not
+             * block, e.g. an event loop.
+             *
+             * The file is read, tokenized and the changed values validated
+             * without holding the lock that set() and the other loads take;
+             * only publishing the result does, and if something else was
+             * published meanwhile the whole file is applied again under it.
+             * Requests run one at a time on a thread of this Config. A request
+             * superseded by a newer reloadAsync() or awaitReload() before it
+             * published anything stops and ends with `cancelled` set. Errors
+             * are reported through the future like reload() throws them.
+             * Change callbacks run on the background thread.
+             */
+            std::future<ReloadResult> reloadAsync() {
+                auto promise                     = std::make_shared<std::promise<ReloadResult>>();
+                std::future<ReloadResult> future = promise->get_future();
+                postReload([promise](ReloadResult result, std::exception_ptr error) {
+                    if (error) {
+                        promise->set_exception(std::move(error));
+                    } else {
+                        promise->set_value(std::move(result));
+                    }
+                });
+                return future;
+            }
+
+            // Same as reloadAsync() for coroutines: `co_await cfg.awaitReload()`
+            // yields the ReloadResult. The coroutine resumes on the background
+            // thread.
+            ReloadAwaiter awaitReload() {
+                return ReloadAwaiter(*this);
+            }
+
+            // Registers a callback fired after a reload changed the value of `key`.
+            void onChange(const ParamsDict &key, ChangeCallback callback) {
+                std::lock_guard<std::mutex> lock(_callbackMutex);
+                _callbacks[key].push_back(std::move(callback));
+            }
+
+            // Registers a check run on every new value of `key` before it is
+            // published, after the parameter accepted it. A check that throws
+            // rejects the value like the parameter itself would, as a
+            // ConfigurationError; clear() removes the checks.
+            void addCheck(const ParamsDict &key, CheckCallback check) {
+                std::lock_guard<std::mutex> lock(_callbackMutex);
+                _checks[key].push_back(std::move(check));
+            }
+
+            // Receives the exceptions thrown by change callbacks. The change
+            // is published by then, so an exception never reaches the caller
+            // of the reload or set(); it is passed here, or dropped without a
+            // handler, and the remaining callbacks still run.
+            void onCallbackError(ErrorCallback handler) {
+                std::lock_guard<std::mutex> lock(_callbackMutex);
+                _callbackError = std::move(handler);
+            }
+
+            // Reloads the file in the background whenever it is modified, with
+            // reload(), so a write that changes no value publishes nothing.
+            // Bursts of writes closer than `debounce` result in a single
+            // reload. Errors raised by a reload keep the previous configuration
+            // and are passed to `onError`.
+            void startWatching(std::chrono::milliseconds debounce = std::chrono::milliseconds(100), ErrorCallback onError = nullptr) {
+                stopWatching();
+                _watcher = std::make_unique<FileWatcher>(_path, debounce, [this, onError]() {
+                    try {
+                        reload();
+                    } catch (...) {
+                        if (onError) {
+                            onError(std::current_exception());
+                        }
+                    }
+                });
+            }
+
+            void stopWatching() {
+                _watcher.reset();
             }
 
             void clear() {
-                _paramCollection.clear();
+                stopWatching();
+                {
+                    std::lock_guard<std::mutex> lock(_callbackMutex);
+                    _callbacks.clear();
+                    _checks.clear();
+                    _callbackError = nullptr;
+                }
+                std::lock_guard<std::mutex> lock(_loadMutex);
+                _registration.reset();
+                _schema = emptySchema();
+                _schemas.store(_schema);
+                _schemaDirty.store(false, std::memory_order_release);
+                if constexpr (Arena) {
+                    _arena = std::make_shared<ParameterArena>();
+                }
+                if constexpr (Stats) {
+                    _stats.reset();
+                    _stats.track(typename Snapshot::Storage());
+                }
+                publish(typename Snapshot::Storage(), typename Snapshot::Sources());
+            }
+
+            // Replaced values are reclaimed without it, but the objects of one
+            // reload end up spread over the arena's pools. This copies the
+            // current parameters into a fresh arena and publishes them; the old
+            // arena is released with the last snapshot using it, so a
+            // ParameterRef obtained from get() before keeps the old one.
+            void compact()
+                requires ConfigArenaTraits<ParamsDict>::enabled
+            {
+                std::lock_guard<std::mutex> lock(_loadMutex);
+                freezeLocked();
+                std::shared_ptr<const Snapshot> current = _snapshot.load();
+                typename Snapshot::Storage params       = current->params();
+                moveToFreshArena(params);
+                publish(std::move(params), current->sources());
+            }
+
+            // Reads through get() and value<T>() per parameter, reload
+            // durations and problems found in loaded files, counted since
+            // construction or clear(). Reads through a snapshot are not
+            // counted.
+            ConfigStatistics statistics() const
+                requires ConfigStatsTraits<ParamsDict>::enabled
+            {
+                freeze();
+                return _schemas.read([this](const Schema &schema) { return _stats.collect(schema.params()); });
             }
 
         protected:
             //
         private:
-            Config() {
-            }
-            ~Config() {
+            Config() : Config(emptySchema(), _confFileName) {
             }
-            std::map<ParamsDict, std::shared_ptr<ConfigParameter>> _paramCollection;
-            std::map<std::string, ParamsDict> _params2enums;
+
+            using StatsCounters = std::conditional_t<Stats, ConfigStats<ParamsDict>, NoStats>;
+
+            /*
+             * Last value read for each key, applied after the whole input was
+             * read. The chunk a value was read from is gone by then, so a
+             * value is either copied, or, when it equals the current one and
+             * will not be applied, refers to the string of the current
+             * parameter, which costs nothing. pin() keeps the snapshot or
+             * schema owning the referred strings alive.
+             */
+            class Staged {
+                public:
+                    Staged()                          = default;
+                    Staged(Staged &&)                 = default;
+                    Staged &operator=(Staged &&)      = default;
+                    Staged(const Staged &)            = delete;
+                    Staged &operator=(const Staged &) = delete;
+
+                    // `value` has to outlive the staged values, see pin().
+                    void refer(const ParamsDict &key, const std::string &value) {
+                        _values.insert(key, &value);
+                    }
+
+                    void insert(const ParamsDict &key, std::string value) {
+                        _owned.push_back(std::move(value));
+                        _values.insert(key, &_owned.back());
+                    }
+
+                    void pin(std::shared_ptr<const void> owner) {
+                        _owner = std::move(owner);
+                    }
+
+                    bool contains(const ParamsDict &key) const {
+                        return _values.contains(key);
+                    }
+
+                    const std::string &at(const ParamsDict &key) const {
+                        return *_values.at(key);
+                    }
+
+                    bool empty() const {
+                        return _values.empty();
+                    }
+
+                    template <typename F>
+                    void forEach(F &&f) const {
+                        _values.forEach([&f](const ParamsDict &key, const std::string *value) { f(key, *value); });
+                    }
+
+                protected:
+                    //
+                private:
+                    ConfigStorage<ParamsDict, const std::string *> _values;
+                    std::deque<std::string> _owned;  // copied values; a deque keeps their addresses
+                    std::shared_ptr<const void> _owner;
+            };
+
+            // Staged values checked by set() on a copy, not yet published.
+            using Validated = ConfigStorage<ParamsDict, std::shared_ptr<const ConfigParameter>>;
+
+            // Issues found while loading file `path`. The line and column of
+            // each staged value are kept to report the rejected ones.
+            struct Diagnostics {
+                    const std::string &path;
+                    LoadMode mode;
+                    LoadReport &report;
+                    ConfigStorage<ParamsDict, std::pair<std::size_t, std::size_t>> positions;
+            };
+
+            struct Change {
+                    ParamsDict key;
+                    Handle previous;
+                    Handle current;
+                    std::shared_ptr<const Snapshot> base;  // holding `previous`, which keeps both from being reclaimed
+            };
+
+            // What reload() saw in the file it applied last.
+            struct ReloadState {
+                    SourceStamp stamp;
+                    std::uint64_t content;     // hashContent() of the whole file
+                    std::uint64_t generation;  // published when the state was recorded
+                    ConfigStorage<ParamsDict, std::uint64_t> values;  // hashCombine() of the last value of each key
+            };
+
+            const std::string _path;
+            mutable std::shared_ptr<ParameterArena> _arena;  // only with ConfigArenaTraits enabled
+            mutable AtomicSnapshot<Snapshot> _snapshot;  // also published by freeze()
+            mutable std::atomic<std::uint64_t> _generation;  // of _snapshot, for ValueHandle
+            mutable std::shared_ptr<const Schema> _schema;  // writer side copy of _schemas
+            mutable AtomicSnapshot<Schema> _schemas;
+            mutable std::atomic<bool> _schemaDirty;
+            std::unique_ptr<typename Schema::Builder> _registration;  // parameters added by addParam()
+            mutable std::mutex _loadMutex;  // serializes writers, value<T>() never takes it
+            std::mutex _saveMutex;
+            std::map<ParamsDict, std::vector<ChangeCallback>> _callbacks;
+            std::map<ParamsDict, std::vector<CheckCallback>> _checks;
+            ErrorCallback _callbackError;
+            mutable std::mutex _callbackMutex;  // also guards _checks and _callbackError
+            std::unique_ptr<FileWatcher> _watcher;
+            std::optional<ReloadState> _reloadState;  // guarded by _loadMutex
+            std::atomic<std::uint64_t> _reloadTicket{0};  // of the latest reloadAsync() request
+            std::mutex _reloaderMutex;
+            std::unique_ptr<SerialExecutor> _reloader;  // started by the first reloadAsync()
+            std::mutex _saverMutex;
+            std::unique_ptr<SerialExecutor> _saver;  // started by the first saveToFileAsync()
+            [[no_unique_address]] mutable StatsCounters _stats;  // only with ConfigStatsTraits enabled
             static const std::string _confFileName;
 
-            std::pair<std::string, std::string> splitParam(const std::string &in, char delimiter) {
-                size_t delimiterPos = in.find_first_of(delimiter);
-                return {in.substr(0, delimiterPos), in.substr(delimiterPos + 1)};
+            void loadFile(const std::string &path, bool createMissing, std::optional<Diagnostics> diagnostics = std::nullopt) {
+                std::vector<Change> changes;
+                {
+                    std::lock_guard<std::mutex> lock(_loadMutex);
+                    typename StatsCounters::ReloadTimer timer(_stats);
+                    freezeLocked();
+                    loadFileLocked(path, createMissing, changes, diagnostics ? &*diagnostics : nullptr);
+                }
+                notify(changes);
+            }
+
+            void loadFileLocked(const std::string &path, bool createMissing, std::vector<Change> &changes, Diagnostics *diagnostics) {
+                Staged staged;
+                if (!stage(path, staged, diagnostics)) {
+                    if (!createMissing) {
+                        throw ConfigurationError("Cannot open configuration file `" + path + "`");
+                    }
+                    writeMissing();
+                }
+                apply(staged, sourcesFrom(staged, path), changes, diagnostics);
+            }
+
+            // Writes `snapshot` to the instance file. Takes _saveMutex, so the
+            // caller may hold _loadMutex but must not take it meanwhile.
+            void writeSnapshot(const Snapshot &snapshot) {
+                std::lock_guard<std::mutex> lock(_saveMutex);
+                writeFileAtomically(_path, serialize(snapshot));
+            }
+
+            // Creates the missing instance file from the current values. A
+            // location that cannot be written keeps them without the file.
+            void writeMissing() {
+                try {
+                    writeSnapshot(*_snapshot.load());
+                } catch (const ConfigurationError &) {
+                    // the file is only a template for the user to edit
+                }
+            }
+
+            void publish(typename Snapshot::Storage params, typename Snapshot::Sources sources) const {
+                std::shared_ptr<const Snapshot> current = _snapshot.load();
+                std::uint64_t generation                = current->generation() + 1;
+                auto next = std::make_shared<const Snapshot>(std::move(params), std::move(sources), generation, _arena);
+                _snapshot.store(next);
+                // after the snapshot, so a handle that sees the new generation
+                // also reads the new values
+                _generation.store(generation, std::memory_order_release);
+                if constexpr (Arena) {
+                    std::vector<const ConfigParameter *> added;
+                    std::vector<const ConfigParameter *> replaced;
+                    next->params().forEach([&](const ParamsDict &key, const Handle &param) {
+                        if (!current->params().contains(key) || current->params().at(key) != param) {
+                            added.push_back(param);
+                        }
+                    });
+                    current->params().forEach([&](const ParamsDict &key, const Handle &param) {
+                        if (!next->params().contains(key) || next->params().at(key) != param) {
+                            replaced.push_back(param);
+                        }
+                    });
+                    _arena->published(generation, next, added, replaced);
+                    current.reset();
+                    _arena->reclaim();
+                }
+            }
+
+            static typename Snapshot::Sources defaultSources(const Schema &schema) {
+                typename Snapshot::Sources sources;
+                schema.params().forEach([&sources](const ParamsDict &key, const std::shared_ptr<const ConfigParameter> &) {
+                    sources.insert(key, ValueSource::defaults());
+                });
+                return sources;
+            }
+
+            // Current sources, with the staged keys attributed to file `path`.
+            typename Snapshot::Sources sourcesFrom(const Staged &staged, const std::string &path) const {
+                typename Snapshot::Sources sources = _snapshot.load()->sources();
+                auto source                        = std::make_shared<const ValueSource>(ValueSource{ValueSource::Kind::File, path});
+                staged.forEach([&sources, &source](const ParamsDict &key, const std::string &) {
+                    sources.insert(key, source);
+                });
+                return sources;
+            }
+
+            static std::shared_ptr<const Schema> emptySchema() {
+                return typename Schema::Builder().build();
+            }
+
+            // Copies `params` into a new arena, which becomes the current one.
+            void moveToFreshArena(typename Snapshot::Storage &params) const {
+                auto arena = std::make_shared<ParameterArena>();
+                typename Snapshot::Storage copied;
+                params.forEach([&arena, &copied](const ParamsDict &key, const Handle &param) {
+                    copied.insert(key, arena->clone(*param));
+                });
+                params = std::move(copied);
+                _arena = std::move(arena);
+            }
+
+            // Parameter object used by snapshots for a newly registered parameter.
+            Handle adopt(const std::shared_ptr<const ConfigParameter> &param) const {
+                if constexpr (Arena) {
+                    return _arena->clone(*param);
+                } else {
+                    return param;
+                }
+            }
+
+            typename Snapshot::Storage adoptAll(const Schema &schema) {
+                typename Snapshot::Storage params;
+                schema.params().forEach([this, &params](const ParamsDict &key, const std::shared_ptr<const ConfigParameter> &param) {
+                    params.insert(key, adopt(param));
+                });
+                return params;
+            }
+
+            // Copy of `previous` holding `value`, the new value of `key`.
+            Handle update(const ParamsDict &key, const ConfigParameter &previous, const std::string &value) {
+                if constexpr (Arena) {
+                    ConfigParameter *updated = _arena->clone(previous);
+                    try {
+                        updated->set(value);
+                        check(key, *updated);
+                    } catch (...) {
+                        _arena->destroy(updated);
+                        throw;
+                    }
+                    return updated;
+                } else {
+                    std::shared_ptr<ConfigParameter> updated = previous.clone();
+                    updated->set(value);
+                    check(key, *updated);
+                    return updated;
+                }
+            }
+
+            // Runs the checks registered by addCheck() for `key` on `candidate`.
+            void check(const ParamsDict &key, const ConfigParameter &candidate) const {
+                std::vector<CheckCallback> checks;
+                {
+                    std::lock_guard<std::mutex> lock(_callbackMutex);
+                    auto it = _checks.find(key);
+                    if (it == _checks.end()) {
+                        return;
+                    }
+                    checks = it->second;
+                }
+                for (const auto &callback : checks) {
+                    try {
+                        callback(candidate);
+                    } catch (const ConfigurationError &) {
+                        throw;
+                    } catch (const std::exception &e) {
+                        throw ConfigurationError("Value `" + candidate.value() + "` of `" + candidate.name() + "` is rejected: " + e.what());
+                    }
+                }
+            }
+
+            // Copy of `previous` holding `value`, which set() produced before.
+            // The checks still run, they may be newer than the value.
+            Handle restore(const ParamsDict &key, const ConfigParameter &previous, ConfigValue value) {
+                if constexpr (Arena) {
+                    ConfigParameter *restored = _arena->clone(previous);
+                    restored->restore(std::move(value));
+                    try {
+                        check(key, *restored);
+                    } catch (...) {
+                        _arena->destroy(restored);
+                        throw;
+                    }
+                    return restored;
+                } else {
+                    std::shared_ptr<ConfigParameter> restored = previous.clone();
+                    restored->restore(std::move(value));
+                    check(key, *restored);
+                    return restored;
+                }
+            }
+
+            // apply() for the entries of a binary cache, attributed to the file.
+            void applyCached(const BinaryCache &cache, std::vector<Change> &changes) {
+                std::shared_ptr<const Snapshot> current = _snapshot.load();
+                typename Snapshot::Storage params       = current->params();
+                typename Snapshot::Sources sources      = current->sources();
+                auto source                             = std::make_shared<const ValueSource>(ValueSource{ValueSource::Kind::File, _path});
+                const std::size_t first                 = changes.size();
+                try {
+                    for (const auto &entry : cache.entries()) {
+                        const auto key = static_cast<ParamsDict>(entry.key);
+                        sources.insert(key, source);
+                        const Handle &previous = params.at(key);
+                        if (previous->value() == entry.raw) {
+                            continue;
+                        }
+                        Handle restored = restore(key, *previous, ConfigValue(std::string(entry.raw), entry.parsed));
+                        changes.push_back({key, previous, restored, current});
+                        params.insert(key, std::move(restored));
+                    }
+                } catch (...) {
+                    if constexpr (Arena) {
+                        for (std::size_t i = first; i < changes.size(); ++i) {
+                            _arena->destroy(changes[i].current);
+                        }
+                    }
+                    changes.resize(first);
+                    throw;
+                }
+                publish(std::move(params), std::move(sources));
+            }
+
+            static void writeCache(const std::string &path, std::uint64_t hash, const SourceStamp &source, std::uint64_t content,
+                                   const std::vector<BinaryCache::Entry> &entries) {
+                try {
+                    BinaryCache::write(path, hash, source, content, entries);
+                } catch (const ConfigurationError &) {
+                    // the cache is an optimisation only
+                }
+            }
+
+            // Only the last occurrence of a key matters, so the file is streamed
+            // through the tokenizer and the values are applied once per key.
+            // Only values that differ from the current ones are copied.
+            // Returns false if the file cannot be opened.
+            bool stage(const std::string &path, Staged &staged, Diagnostics *diagnostics = nullptr) const {
+                const Names &names                      = _schema->names();
+                std::shared_ptr<const Snapshot> current = _snapshot.load();
+                staged.pin(current);
+                IniTokenizer tokenizer;
+                return parseFile(
+                    path, tokenizer,
+                    [&](std::string_view name, std::string_view value) {
+                        const ParamsDict *key = names.find(name);
+                        if (key != nullptr) {
+                            if (diagnostics != nullptr && staged.contains(*key)) {
+                                // only the last value is validated, so the earlier one is reported here
+                                const auto &[line, column] = diagnostics->positions.at(*key);
+                                diagnostics->report.add({path, line, column, std::string(name), LoadIssue::Reason::DuplicateKey,
+                                                         "value `" + staged.at(*key) + "` is ignored, the key is set again on line " +
+                                                             std::to_string(tokenizer.line())});
+                            }
+                            const std::string &previous = current->params().at(*key)->value();
+                            if (value == previous) {
+                                staged.refer(*key, previous);
+                            } else {
+                                staged.insert(*key, std::string(value));
+                            }
+                            if (diagnostics != nullptr) {
+                                diagnostics->positions.insert(*key, {tokenizer.line(), tokenizer.valueColumn()});
+                            }
+                        } else {
+                            if constexpr (Stats) {
+                                _stats.countUnknown();
+                            }
+                            if (diagnostics != nullptr) {
+                                diagnostics->report.add({path, tokenizer.line(), tokenizer.column(), std::string(name), LoadIssue::Reason::UnknownKey,
+                                                         "no parameter is registered under this name"});
+                            }
+                        }
+                    },
+                    [&]() {
+                        if constexpr (Stats) {
+                            _stats.countMalformed();
+                        }
+                        if (diagnostics != nullptr) {
+                            diagnostics->report.add({path, tokenizer.line(), tokenizer.column(), "", LoadIssue::Reason::Malformed, tokenizer.error()});
+                        }
+                    });
             }
+
+            // Tokenizes `content` and records the hash of the last value of
+            // every key in `hashes`. Only keys whose last value hashes
+            // differently than in `previous` are staged; without `previous`
+            // every key is.
+            Staged stageChanged(const Names &names, std::string_view content, const ConfigStorage<ParamsDict, std::uint64_t> *previous,
+                                ConfigStorage<ParamsDict, std::uint64_t> &hashes) const {
+                // a later duplicate of a key may bring back the previous value
+                ConfigStorage<ParamsDict, std::optional<std::string>> candidates;
+                IniTokenizer tokenizer;
+                auto entry = [&](std::string_view name, std::string_view value) {
+                    const ParamsDict *key = names.find(name);
+                    if (key == nullptr) {
+                        if constexpr (Stats) {
+                            _stats.countUnknown();
+                        }
+                        return;
+                    }
+                    const std::uint64_t hash = hashCombine(HashSeed, value);
+                    hashes.insert(*key, hash);
+                    if (previous != nullptr && previous->contains(*key) && previous->at(*key) == hash) {
+                        if (candidates.contains(*key)) {
+                            candidates.insert(*key, std::nullopt);
+                        }
+                    } else {
+                        candidates.insert(*key, std::string(value));
+                    }
+                };
+                auto malformed = [this]() {
+                    if constexpr (Stats) {
+                        _stats.countMalformed();
+                    }
+                };
+                tokenizer.feed(content, entry, malformed);
+                tokenizer.finish(entry, malformed);
+
+                Staged staged;
+                candidates.forEach([&staged](const ParamsDict &key, const std::optional<std::string> &value) {
+                    if (value) {
+                        staged.insert(key, *value);
+                    }
+                });
+                return staged;
+            }
+
+            // Copies the current table, replaces the parameters whose value
+            // changed and publishes the result together with `sources`. A
+            // rejected value throws before anything is published, unless
+            // `diagnostics` collects it; then the whole table is checked and
+            // a Strict load throws only at the end.
+            void apply(const Staged &staged, typename Snapshot::Sources sources, std::vector<Change> &changes, Diagnostics *diagnostics = nullptr) {
+                std::shared_ptr<const Snapshot> current = _snapshot.load();
+                typename Snapshot::Storage params       = current->params();
+                const std::size_t first                 = changes.size();
+                // copies made for a load that throws are never published
+                auto discard = [&]() {
+                    if constexpr (Arena) {
+                        for (std::size_t i = first; i < changes.size(); ++i) {
+                            _arena->destroy(changes[i].current);
+                        }
+                    }
+                    changes.resize(first);
+                };
+                staged.forEach([&](const ParamsDict &key, const std::string &value) {
+                    const Handle &previous = params.at(key);
+                    if (previous->value() == value) {
+                        return;
+                    }
+                    Handle updated;
+                    try {
+                        updated = update(key, *previous, value);
+                    } catch (const ConfigurationError &e) {
+                        if constexpr (Stats) {
+                            _stats.countRejected();
+                        }
+                        if (diagnostics == nullptr) {
+                            discard();
+                            throw;
+                        }
+                        const auto &[line, column] = diagnostics->positions.at(key);
+                        diagnostics->report.add({diagnostics->path, line, column, previous->name(), LoadIssue::Reason::InvalidValue, e.what()});
+                        sources.insert(key, current->sources().at(key));
+                        return;
+                    }
+                    changes.push_back({key, previous, updated, current});
+                    params.insert(key, std::move(updated));
+                });
+                if (diagnostics != nullptr && diagnostics->mode == LoadMode::Strict && !diagnostics->report.ok()) {
+                    discard();
+                    throw ConfigLoadError(diagnostics->report);
+                }
+                publish(std::move(params), std::move(sources));
+            }
+
+            // Queues a reloadAsync() request; `done` gets its result or error on
+            // the background thread.
+            template <class Done>
+            void postReload(Done done) {
+                const std::uint64_t ticket = _reloadTicket.fetch_add(1, std::memory_order_acq_rel) + 1;
+                std::lock_guard<std::mutex> lock(_reloaderMutex);
+                if (!_reloader) {
+                    _reloader = std::make_unique<SerialExecutor>();
+                }
+                _reloader->post([this, ticket, done = std::move(done)]() mutable {
+                    ReloadResult result;
+                    std::exception_ptr error;
+                    try {
+                        result = reloadInBackground(ticket);
+                    } catch (...) {
+                        error = std::current_exception();
+                    }
+                    done(std::move(result), std::move(error));
+                });
+            }
+
+            // reload() split around the lock: the state is captured, the file
+            // staged and validated unlocked, and the lock is taken again to
+            // publish. Stops between the steps once `ticket` is superseded.
+            ReloadResult reloadInBackground(std::uint64_t ticket) {
+                ReloadResult result;
+                auto superseded = [this, ticket]() { return _reloadTicket.load(std::memory_order_acquire) != ticket; };
+                if (superseded()) {
+                    result.cancelled = true;
+                    return result;
+                }
+                const SourceStamp stamp = SourceStamp::of(_path);
+                if (!stamp.exists) {
+                    return reload();  // writes the defaults
+                }
+
+                typename StatsCounters::ReloadTimer timer(_stats);
+                std::shared_ptr<const Schema> schema;
+                std::shared_ptr<const Snapshot> base;
+                std::optional<ReloadState> state;
+                {
+                    std::lock_guard<std::mutex> lock(_loadMutex);
+                    freezeLocked();
+                    schema = _schema;
+                    base   = _snapshot.load();
+                    if (_reloadState && _reloadState->generation == base->generation()) {
+                        state = _reloadState;
+                    }
+                }
+                if (state && stamp == state->stamp) {
+                    result.skipped = true;
+                    return result;
+                }
+                MappedFile file(_path);
+                if (!file.is_open()) {
+                    throw ConfigurationError("Cannot open configuration file `" + _path + "`");
+                }
+                const std::uint64_t content = hashContent(file.content());
+                ReloadState next{stamp.settled() ? stamp : SourceStamp{}, content, 0, {}};
+                if (state && content == state->content) {
+                    std::lock_guard<std::mutex> lock(_loadMutex);
+                    if (_reloadState && _reloadState->generation == state->generation) {
+                        _reloadState->stamp = next.stamp;
+                    }
+                    result.skipped = true;
+                    return result;
+                }
+
+                Staged staged = stageChanged(schema->names(), file.content(), state ? &state->values : nullptr, next.values);
+                if (superseded()) {
+                    result.cancelled = true;
+                    return result;
+                }
+                Validated validated = validate(*base, staged);
+
+                std::vector<Change> changes;
+                {
+                    std::lock_guard<std::mutex> lock(_loadMutex);
+                    if (superseded()) {
+                        result.cancelled = true;
+                        return result;
+                    }
+                    if (_snapshot.load() == base) {
+                        if (!state || !staged.empty()) {
+                            commit(*base, validated, sourcesFrom(staged, _path), changes);
+                        }
+                    } else {
+                        // the staged keys and checked values may be stale now
+                        freezeLocked();
+                        next.values.clear();
+                        Staged all = stageChanged(_schema->names(), file.content(), nullptr, next.values);
+                        apply(all, sourcesFrom(all, _path), changes);
+                    }
+                    next.generation = _snapshot.load()->generation();
+                    _reloadState    = std::move(next);
+                }
+                for (const auto &change : changes) {
+                    result.changed.push_back(change.key);
+                }
+                notify(changes);
+                return result;
+            }
+
+            // Checks the staged values against `base` on copies, leaving the
+            // arena and the published table alone, so it needs no lock.
+            // Values equal to the current one are left out; a rejected value
+            // throws.
+            Validated validate(const Snapshot &base, const Staged &staged) const {
+                Validated validated;
+                staged.forEach([&](const ParamsDict &key, const std::string &value) {
+                    const Handle &previous = base.params().at(key);
+                    if (previous->value() == value) {
+                        return;
+                    }
+                    std::shared_ptr<ConfigParameter> updated = previous->clone();
+                    try {
+                        updated->set(value);
+                        check(key, *updated);
+                    } catch (const ConfigurationError &) {
+                        if constexpr (Stats) {
+                            _stats.countRejected();
+                        }
+                        throw;
+                    }
+                    validated.insert(key, std::move(updated));
+                });
+                return validated;
+            }
+
+            // Publishes `validated` on top of `base`, the current snapshot.
+            void commit(const Snapshot &base, const Validated &validated, typename Snapshot::Sources sources, std::vector<Change> &changes) {
+                typename Snapshot::Storage params = base.params();
+                validated.forEach([&](const ParamsDict &key, const std::shared_ptr<const ConfigParameter> &param) {
+                    Handle updated = adopt(param);
+                    changes.push_back({key, params.at(key), updated, base.shared_from_this()});
+                    params.insert(key, std::move(updated));
+                });
+                publish(std::move(params), std::move(sources));
+            }
+
+            void freezeLocked() const {
+                if (!_schemaDirty.load(std::memory_order_acquire)) {
+                    return;
+                }
+                std::shared_ptr<const Schema> previous = std::move(_schema);
+                _schema                                = _registration->build();
+                _schemas.store(_schema);
+
+                // parameters registered or replaced since the previous schema
+                std::shared_ptr<const Snapshot> current = _snapshot.load();
+                typename Snapshot::Storage params       = current->params();
+                typename Snapshot::Sources sources      = current->sources();
+                _schema->params().forEach([&](const ParamsDict &key, const std::shared_ptr<const ConfigParameter> &param) {
+                    if (!previous->params().contains(key) || previous->params().at(key) != param) {
+                        params.insert(key, adopt(param));
+                        sources.insert(key, ValueSource::defaults());
+                    }
+                });
+                if constexpr (Stats) {
+                    _stats.track(params);
+                }
+                publish(std::move(params), std::move(sources));
+                _schemaDirty.store(false, std::memory_order_release);
+            }
+
+            // Runs every callback of every changed key, also after one of
+            // them threw; see onCallbackError().
+            void notify(const std::vector<Change> &changes) {
+                for (const auto &change : changes) {
+                    std::vector<ChangeCallback> callbacks;
+                    ErrorCallback onError;
+                    {
+                        std::lock_guard<std::mutex> lock(_callbackMutex);
+                        auto it = _callbacks.find(change.key);
+                        if (it == _callbacks.end()) {
+                            continue;
+                        }
+                        callbacks = it->second;
+                        onError   = _callbackError;
+                    }
+                    for (const auto &callback : callbacks) {
+                        try {
+                            callback(*change.previous, *change.current);
+                        } catch (...) {
+                            if (onError) {
+                                onError(std::current_exception());
+                            }
+                        }
+                    }
+                }
+            }
+
     };
 
 };  // namespace cpp_config
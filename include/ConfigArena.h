@@ -0,0 +1,133 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#ifndef CONFIGARENA_H
+#define CONFIGARENA_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "ConfigParameter.h"
+
+namespace cpp_config {
+
+    /*
+     * Selects how Config<ParamsDict> owns its parameters.
+     *
+     * By default every parameter is a separate std::shared_ptr and get()
+     * hands out shared ownership. Specializing this trait with
+     * `enabled = true` places the parameters in a ParameterArena owned by the
+     * Config instead: snapshots hold plain pointers, so snapshot reads and
+     * value<T>() never touch a reference count, and get() returns a
+     * ParameterRef holding the snapshot the parameter was read from.
+     */
+    template <class ParamsDict>
+    struct ConfigArenaTraits {
+            static constexpr bool enabled = false;
+    };
+
+    template <class ParamsDict>
+    using ParameterHandle = std::conditional_t<ConfigArenaTraits<ParamsDict>::enabled, const ConfigParameter *, std::shared_ptr<const ConfigParameter>>;
+
+    /*
+     * Storage for parameter objects, reclaimed by snapshot lifetime.
+     *
+     * Parameters are copied into pooled chunks, so objects of one class sit
+     * next to each other in memory. Short strings live inline in the
+     * objects; longer ones are still allocated by std::string, so only the
+     * objects themselves are bounded by the arena.
+     *
+     * Config reports every published snapshot with the parameters it added
+     * and the ones it replaced. A replaced parameter is destroyed by
+     * reclaim() once no snapshot published while it was current is alive,
+     * so the arena holds the current values plus whatever the snapshots
+     * still held by readers use. Parameters never published, such as a
+     * copy that rejected its new value, are handed back with destroy().
+     *
+     * Only writers use the arena and they are serialized by Config.
+     */
+    class ParameterArena {
+        public:
+            ParameterArena();
+            ~ParameterArena();
+            ParameterArena(const ParameterArena &)            = delete;
+            ParameterArena &operator=(const ParameterArena &) = delete;
+
+            // Copies `param`, keeping its dynamic type, into the arena.
+            // cloneInto() must allocate the object and nothing else.
+            ConfigParameter *clone(const ConfigParameter &param);
+
+            // Destroys a copy made by clone() that was never published.
+            void destroy(const ConfigParameter *param);
+
+            // Records `snapshot`, published as `generation`, which holds
+            // `added` in place of `replaced`. Parameters of another arena
+            // are ignored.
+            void published(std::uint64_t generation, std::weak_ptr<const void> snapshot, const std::vector<const ConfigParameter *> &added,
+                           const std::vector<const ConfigParameter *> &replaced);
+
+            // Destroys the replaced parameters no live snapshot holds any
+            // more and returns how many.
+            std::size_t reclaim();
+
+            // Parameters currently held by the arena.
+            std::size_t size() const;
+
+        protected:
+            //
+        private:
+            struct Object {
+                    ConfigParameter *object;
+                    void *block;
+                    std::size_t bytes;
+                    std::size_t alignment;
+                    std::uint64_t added;     // generation of the first snapshot holding it
+                    std::uint64_t replaced;  // generation of the first snapshot not holding it
+            };
+
+            struct Published {
+                    std::uint64_t generation;
+                    std::weak_ptr<const void> snapshot;
+            };
+
+            // Forwards to the pool and remembers the block cloneInto() took.
+            class Recorder : public std::pmr::memory_resource {
+                public:
+                    explicit Recorder(std::pmr::memory_resource &upstream);
+
+                    void *block;
+                    std::size_t bytes;
+                    std::size_t alignment;
+
+                private:
+                    std::pmr::memory_resource &_upstream;
+
+                    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+                    void do_deallocate(void *block, std::size_t bytes, std::size_t alignment) override;
+                    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+            };
+
+            void release(std::unordered_map<const ConfigParameter *, Object>::iterator it);
+
+            std::pmr::unsynchronized_pool_resource _memory;
+            std::unordered_map<const ConfigParameter *, Object> _objects;
+            std::vector<const ConfigParameter *> _replaced;  // published, no longer current
+            std::vector<Published> _snapshots;               // in generation order, expired ones pruned by reclaim()
+    };
+};  // namespace cpp_config
+#endif
@@ -0,0 +1,67 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#ifndef CONFIGBATCH_H
+#define CONFIGBATCH_H
+
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <string>
+#include <vector>
+
+#include "Config.h"
+#include "ConfigThreadPool.h"
+
+namespace cpp_config {
+
+    // One file to load and the instance it is loaded into.
+    template <class ParamsDict>
+    struct LoadJob {
+            Config<ParamsDict> *target;
+            std::string path;
+    };
+
+    // Outcome of one LoadJob; `error` is empty when the file was applied.
+    struct LoadResult {
+            std::string path;
+            std::exception_ptr error;
+
+            bool ok() const {
+                return !error;
+            }
+    };
+
+    /*
+     * Loads every job on `pool` and returns one result per job, in job order.
+     *
+     * A file that is missing or holds a rejected value only fails its own job;
+     * the target keeps its previous values and the rest of the batch still
+     * runs. Jobs for the same instance are serialized by that instance, in no
+     * particular order. Change callbacks run on the pool threads.
+     */
+    template <class ParamsDict>
+    std::vector<LoadResult> loadBatch(const std::vector<LoadJob<ParamsDict>> &jobs, WorkStealingPool &pool) {
+        std::vector<LoadResult> results(jobs.size());
+        pool.parallelFor(jobs.size(), [&jobs, &results](std::size_t i) {
+            results[i].path = jobs[i].path;
+            try {
+                jobs[i].target->loadFromFile(jobs[i].path);
+            } catch (...) {
+                results[i].error = std::current_exception();
+            }
+        });
+        return results;
+    }
+}  // namespace cpp_config
+
+#endif
@@ -0,0 +1,207 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#ifndef CONFIGBINDING_H
+#define CONFIGBINDING_H
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Config.h"
+#include "ConfigSnapshot.h"
+
+namespace cpp_config {
+
+    /*
+     * Plain struct filled from a Config, for modules that read several
+     * parameters on a hot path.
+     *
+     * Struct members are bound to keys once; the binding then materializes a
+     * typed copy of the struct in a single pass over the bound keys and
+     * publishes it as an immutable, versioned snapshot. A new copy is built
+     * by the change callbacks of the bound keys, on the thread running the
+     * reload or set() that changed them, so reads never pay for the
+     * conversion. A value that does not convert to its member is rejected
+     * by that reload or set() before it is published, through
+     * Config::addCheck(), like a value the parameter itself rejects. Reading
+     * a field of a materialized copy is a plain member load, without lookup,
+     * parse or reference count.
+     *
+     * Binding must be done before the binding is shared between threads. The
+     * binding must not outlive the Config; its callbacks and checks stay
+     * registered with the Config after it is destroyed and then do nothing.
+     * Config::clear() removes them, after which refresh() has to be called
+     * explicitly.
+     */
+    template <class ParamsDict, class Struct>
+    class ConfigBinding {
+        private:
+            struct State;
+
+        public:
+            static_assert(std::is_default_constructible_v<Struct> && std::is_copy_constructible_v<Struct>,
+                          "Bound struct has to be default and copy constructible.");
+
+            // One materialized copy of the struct, kept on its own cache lines
+            // so that readers of different bindings do not share them.
+            class alignas(64) Bound : public std::enable_shared_from_this<Bound> {
+                public:
+                    Bound(Struct value, std::uint64_t generation) : _value(std::move(value)), _generation(generation) {
+                    }
+
+                    const Struct &value() const {
+                        return _value;
+                    }
+
+                    // Generation of the Config snapshot the copy was built from.
+                    std::uint64_t generation() const {
+                        return _generation;
+                    }
+
+                protected:
+                    //
+                private:
+                    Struct _value;
+                    std::uint64_t _generation;
+            };
+
+            /*
+             * Per-thread view of the binding, see reader(). Keeps the last
+             * materialized copy and compares its generation with the one of
+             * the published copy, a single atomic load, before handing it
+             * out. Not thread-safe: every thread keeps its own copy.
+             */
+            class Reader {
+                public:
+                    explicit Reader(const ConfigBinding &binding) : _state(binding._state.get()), _bound(binding.snapshot()) {
+                    }
+
+                    const Struct &get() {
+                        if (_state->generation.load(std::memory_order_acquire) != _bound->generation()) [[unlikely]] {
+                            _bound = _state->bound.load();
+                        }
+                        return _bound->value();
+                    }
+
+                protected:
+                    //
+                private:
+                    const State *_state;
+                    std::shared_ptr<const Bound> _bound;
+            };
+
+            explicit ConfigBinding(Config<ParamsDict> &config) : _config(config), _state(std::make_shared<State>(config)) {
+            }
+            ConfigBinding(const ConfigBinding &)            = delete;
+            ConfigBinding &operator=(const ConfigBinding &) = delete;
+
+            // Fills `member` from `key` on every materialization. The value is
+            // converted like value<T>(), which throws here already if the key
+            // is not registered or the type does not fit; later values that
+            // do not fit are rejected by the Config.
+            template <typename T>
+            ConfigBinding &bind(T Struct::*member, const ParamsDict &key) {
+                std::lock_guard<std::mutex> lock(_state->mutex);
+                _state->fields.push_back([member, key](Struct &out, const typename Config<ParamsDict>::Snapshot &snapshot) {
+                    out.*member = snapshot.template value<T>(key);
+                });
+                try {
+                    _state->materialize(true);
+                } catch (...) {
+                    _state->fields.pop_back();
+                    throw;
+                }
+                if constexpr (!std::is_same_v<T, std::string>) {
+                    _config.addCheck(key, [state = std::weak_ptr<State>(_state)](const ConfigParameter &candidate) {
+                        if (!state.expired()) {
+                            static_cast<void>(candidate.template as<T>());
+                        }
+                    });
+                }
+                _config.onChange(key, [state = std::weak_ptr<State>(_state)](const ConfigParameter &, const ConfigParameter &) {
+                    if (std::shared_ptr<State> alive = state.lock()) {
+                        std::lock_guard<std::mutex> lock(alive->mutex);
+                        alive->materialize(false);
+                    }
+                });
+                // a change published before the callback was registered
+                _state->materialize(false);
+                return *this;
+            }
+
+            // Current copy of the struct; stays valid across reloads.
+            std::shared_ptr<const Bound> snapshot() const {
+                return _state->bound.load();
+            }
+
+            Reader reader() const {
+                return Reader(*this);
+            }
+
+            // Materializes a new copy if the Config changed since the last
+            // one. Only needed after Config::clear() or registering
+            // parameters; reloads and set() do it through the callbacks.
+            void refresh() const {
+                std::lock_guard<std::mutex> lock(_state->mutex);
+                _state->materialize(false);
+            }
+
+        protected:
+            //
+        private:
+            using Field = std::function<void(Struct &, const typename Config<ParamsDict>::Snapshot &)>;
+
+            // Shared with the change callbacks, which keep it only weakly.
+            struct State {
+                    explicit State(const Config<ParamsDict> &config)
+                        : config(config), bound(std::make_shared<const Bound>(Struct{}, config.generation())), generation(config.generation()) {
+                    }
+
+                    // Another thread may have materialized the same generation
+                    // while this one waited for the mutex; `force` rebuilds
+                    // anyway.
+                    void materialize(bool force) {
+                        std::shared_ptr<const typename Config<ParamsDict>::Snapshot> snapshot = config.snapshot();
+                        if (!force && generation.load(std::memory_order_relaxed) == snapshot->generation()) {
+                            return;
+                        }
+                        Struct value{};
+                        for (const auto &field : fields) {
+                            field(value, *snapshot);
+                        }
+                        bound.store(std::make_shared<const Bound>(std::move(value), snapshot->generation()));
+                        // after the copy, so a reader seeing the generation
+                        // also takes the new copy
+                        generation.store(snapshot->generation(), std::memory_order_release);
+                    }
+
+                    const Config<ParamsDict> &config;
+                    AtomicSnapshot<Bound> bound;
+                    std::atomic<std::uint64_t> generation;  // of `bound`
+                    std::vector<Field> fields;
+                    std::mutex mutex;  // serializes materializations
+            };
+
+            Config<ParamsDict> &_config;
+            std::shared_ptr<State> _state;
+    };
+}  // namespace cpp_config
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#ifndef CONFIGCACHE_H
+#define CONFIGCACHE_H
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "ConfigFile.h"
+#include "ConfigValue.h"
+
+namespace cpp_config {
+
+    // FNV-1a, used to fingerprint the registered schema.
+    inline std::uint64_t hashCombine(std::uint64_t seed, std::string_view data) {
+        for (unsigned char c : data) {
+            seed ^= c;
+            seed *= 1099511628211ULL;
+        }
+        // separator, so that ("ab", "c") and ("a", "bc") differ
+        seed ^= 0xff;
+        seed *= 1099511628211ULL;
+        return seed;
+    }
+
+    constexpr std::uint64_t HashSeed = 14695981039346656037ULL;
+
+    // Fingerprint of a whole file. Consumes eight bytes per step, so hashing
+    // stays cheap next to parsing the same text.
+    inline std::uint64_t hashContent(std::string_view data) {
+        std::uint64_t seed = HashSeed ^ data.size();
+        std::size_t pos    = 0;
+        for (; pos + sizeof(std::uint64_t) <= data.size(); pos += sizeof(std::uint64_t)) {
+            std::uint64_t word;
+            std::memcpy(&word, data.data() + pos, sizeof(word));
+            seed = (seed ^ word) * 1099511628211ULL;
+            seed ^= seed >> 32;  // the multiply only carries upwards
+        }
+        return hashCombine(seed, data.substr(pos));
+    }
+
+    /*
+     * Size and modification time of the text file a cache was built from.
+     */
+    struct SourceStamp {
+            std::uint64_t size   = 0;
+            std::int64_t mtimeNs = 0;
+            bool exists          = false;
+
+            static SourceStamp of(const std::string &path);
+            bool operator==(const SourceStamp &rhs) const = default;
+
+            // Whether the file was modified long enough ago that another
+            // write of the same size would show up as a different mtime.
+            // Timestamps are coarser than writes, so a file changed twice
+            // within one tick can keep both its size and its mtime.
+            bool settled() const;
+    };
+
+    /*
+     * Compiled form of a loaded configuration.
+     *
+     * Layout (native endianness, the cache is only read on the host that
+     * wrote it):
+     *
+     *   char[8]  magic "CPPCFGB"
+     *   u32      format version
+     *   u32      number of entries
+     *   u64      schema hash
+     *   u64      source size
+     *   i64      source mtime in nanoseconds, 0 unless the source had settled
+     *   u64      hashContent() of the source
+     *   entries: i64 key, i64 integer, f64 floating, u8 boolean, u8 flags,
+     *            u32 choice, u32 value length, value bytes
+     *
+     * Entries are stored by key with their typed interpretations, so loading
+     * needs neither tokenizing, name lookups nor parsing the values.
+     */
+    class BinaryCache {
+        public:
+            static constexpr std::uint32_t Version = 2;
+
+            struct Entry {
+                    std::int64_t key;
+                    std::string_view raw;
+                    ConfigValue::Parsed parsed;
+            };
+
+            // Opens `path`; valid() is false if it is missing, malformed, of a
+            // different version or built for another schema.
+            BinaryCache(const std::string &path, std::uint64_t schemaHash);
+
+            bool valid() const;
+            // Whether the cache was built from the file `source` describes,
+            // trusting its size and modification time. Only a source that
+            // had settled when the cache was written is recorded; otherwise
+            // builtFrom(content) has to decide.
+            bool builtFrom(const SourceStamp &source) const;
+            // Whether the cache was built from text hashing to `content`.
+            bool builtFrom(std::uint64_t content) const;
+            const std::vector<Entry> &entries() const;
+
+            static void write(const std::string &path, std::uint64_t schemaHash, const SourceStamp &source, std::uint64_t content,
+                              const std::vector<Entry> &entries);
+
+        protected:
+            //
+        private:
+            MappedFile _file;
+            bool _valid;
+            SourceStamp _source;
+            std::uint64_t _content;
+            std::vector<Entry> _entries;
+    };
+}  // namespace cpp_config
+
+#endif
@@ -14,28 +14,61 @@
 
 #pragma once
 
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+#include "ConfigNameIndex.h"
 #include "ConfigParameter.h"
 
 namespace cpp_config {
+    /*
+     * Parameter restricted to a fixed list of allowed values.
+     *
+     * The list is interned once into an immutable, hashed table shared by all
+     * copies of the parameter, together with the parsed ConfigValue of every
+     * entry, which also holds its position in the list. set() validates with
+     * a single hash lookup and copies that value without parsing the text
+     * again; index(), choice() and as<Enum>() read the current value without
+     * touching any string. as<Enum>(), on the parameter or through
+     * Config::value<Enum>(), maps the position to the enumerator with the
+     * same ordinal, so the list has to be declared in enum order.
+     */
     class ConfigChoice : public ConfigParameter {
         public:
             ConfigChoice();
             ConfigChoice(const std::string &name, const std::string &description, const std::string &value, const std::vector<std::string> &choice);
             ~ConfigChoice() override;
             ConfigChoice(const ConfigChoice &rhs);
-            ConfigChoice(const ConfigChoice &&rhs);
+            ConfigChoice(ConfigChoice &&rhs) noexcept;
             ConfigChoice &operator=(const ConfigChoice &rhs);
-            ConfigChoice &operator=(const ConfigChoice &&rhs);
+            ConfigChoice &operator=(ConfigChoice &&rhs) noexcept;
+            std::shared_ptr<ConfigParameter> clone() const override;
+            ConfigParameter *cloneInto(std::pmr::memory_resource &memory) const override;
             void set(const std::string &val) override;
-            const std::string description() const override;
+            const std::string &description() const override;
+
+            std::size_t index() const;
+            std::string_view choice() const;
+            const std::vector<std::string> &choices() const;
 
         protected:
             //
         private:
-            std::vector<std::string> _choice;
+            struct Choices {
+                    Choices(const std::string &summary, std::vector<std::string> list);
+
+                    std::vector<std::string> values;
+                    std::vector<ConfigValue> parsed;  // of each value, with its position
+                    NameIndex<std::size_t> index;
+                    std::string description;  // base description followed by the list
+            };
+
+            std::shared_ptr<const Choices> _choices;
     };
 }  // namespace cpp_config
 
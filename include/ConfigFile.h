@@ -0,0 +1,71 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#ifndef CONFIGFILE_H
+#define CONFIGFILE_H
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace cpp_config {
+
+    /*
+     * Read-only view of a whole file.
+     *
+     * Large files are memory-mapped so the parser can work on the page cache
+     * directly. Files below MapThreshold are read with a single read() into an
+     * owned buffer instead: for them mmap is not faster, and a copy cannot be
+     * hit by SIGBUS if the file is truncated in place while it is parsed.
+     */
+    class MappedFile {
+        public:
+            static constexpr std::size_t MapThreshold = 256 * 1024;
+
+            explicit MappedFile(const std::string &path);
+            ~MappedFile();
+            MappedFile(const MappedFile &rhs)            = delete;
+            MappedFile &operator=(const MappedFile &rhs) = delete;
+
+            bool is_open() const;
+            bool mapped() const;
+            std::string_view content() const;
+
+        protected:
+            //
+        private:
+            bool _open;
+            void *_mapping;
+            std::size_t _size;
+            std::string _buffer;
+    };
+
+    /*
+     * Calls f(chunk) for consecutive pieces of the file at `path`, read with
+     * a buffer of `chunkSize` bytes, so memory use does not depend on the size
+     * of the file. Returns false if the file cannot be opened.
+     */
+    constexpr std::size_t ReadChunkSize = 64 * 1024;
+    bool readChunks(const std::string &path, const std::function<void(std::string_view)> &f, std::size_t chunkSize = ReadChunkSize);
+
+    /*
+     * Replaces `path` with `content` in a crash-safe way: the data goes to a
+     * temporary file in the same directory with one write, is fsync'd and then
+     * renamed over the target, so readers see either the old or the new file.
+     * Throws ConfigurationError on failure; the target is left untouched.
+     */
+    void writeFileAtomically(const std::string &path, std::string_view content);
+}  // namespace cpp_config
+
+#endif
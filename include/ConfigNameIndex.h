@@ -0,0 +1,93 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#ifndef CONFIGNAMEINDEX_H
+#define CONFIGNAMEINDEX_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cpp_config {
+
+    /*
+     * Frozen name -> key table used to resolve parameter names.
+     *
+     * Built once from the registered names: all names are packed into one
+     * buffer and addressed through an open-addressing hash table with at most
+     * 50% load, storing the full hash next to each slot. A lookup hashes the
+     * string_view once and usually compares a single name.
+     */
+    template <class ParamsDict>
+    class NameIndex {
+        public:
+            template <class Names>
+            explicit NameIndex(const Names &names) {
+                std::size_t capacity = 2;
+                while (capacity < names.size() * 2) {
+                    capacity *= 2;
+                }
+                _slots.resize(capacity);
+                _mask = capacity - 1;
+
+                for (const auto &[name, key] : names) {
+                    std::size_t hash = std::hash<std::string_view>{}(name);
+                    std::size_t pos  = hash & _mask;
+                    while (_slots[pos].offset != Empty) {
+                        pos = (pos + 1) & _mask;
+                    }
+                    _slots[pos] = {hash, static_cast<std::uint32_t>(_text.size()), static_cast<std::uint32_t>(name.size()), key};
+                    _text.append(name);
+                }
+                _size = names.size();
+            }
+
+            const ParamsDict *find(std::string_view name) const {
+                std::size_t hash = std::hash<std::string_view>{}(name);
+                for (std::size_t pos = hash & _mask; _slots[pos].offset != Empty; pos = (pos + 1) & _mask) {
+                    const Slot &slot = _slots[pos];
+                    if (slot.hash == hash && std::string_view(_text).substr(slot.offset, slot.length) == name) {
+                        return &slot.key;
+                    }
+                }
+                return nullptr;
+            }
+
+            std::size_t size() const {
+                return _size;
+            }
+
+        protected:
+            //
+        private:
+            static constexpr std::uint32_t Empty = std::numeric_limits<std::uint32_t>::max();
+
+            struct Slot {
+                    std::size_t hash     = 0;
+                    std::uint32_t offset = Empty;
+                    std::uint32_t length = 0;
+                    ParamsDict key{};
+            };
+
+            std::string _text;
+            std::vector<Slot> _slots;
+            std::size_t _mask = 0;
+            std::size_t _size = 0;
+    };
+
+};  // namespace cpp_config
+#endif
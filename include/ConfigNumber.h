@@ -0,0 +1,159 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#ifndef CONFIGNUMBER_H
+#define CONFIGNUMBER_H
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+#include "ConfigParameter.h"
+
+namespace cpp_config {
+
+    /*
+     * Numeric kinds for ConfigNumber. Each one names the native type, parses
+     * the whole text with std::from_chars (no whitespace, junk or overflow)
+     * and formats bounds for the description.
+     */
+    struct IntegerKind {
+            using Native                             = std::int64_t;
+            static constexpr ConfigValue::Type type  = ConfigValue::Type::Integer;
+            static constexpr const char *name        = "integer";
+
+            static bool parse(std::string_view text, Native &out);
+            static std::string format(Native value);
+            static ConfigValue store(const std::string &raw, Native value);
+            static bool onStep(Native value, Native min, Native step);
+            static constexpr Native lowest() {
+                return std::numeric_limits<Native>::min();
+            }
+            static constexpr Native highest() {
+                return std::numeric_limits<Native>::max();
+            }
+    };
+
+    // Finite numbers only; `inf` and `nan` are rejected.
+    struct FloatKind {
+            using Native                             = double;
+            static constexpr ConfigValue::Type type  = ConfigValue::Type::Floating;
+            static constexpr const char *name        = "floating point number";
+
+            static bool parse(std::string_view text, Native &out);
+            static std::string format(Native value);
+            static ConfigValue store(const std::string &raw, Native value);
+            static bool onStep(Native value, Native min, Native step);
+            static constexpr Native lowest() {
+                return std::numeric_limits<Native>::lowest();
+            }
+            static constexpr Native highest() {
+                return std::numeric_limits<Native>::max();
+            }
+    };
+
+    // Byte count with an optional unit: B, KB/MB/GB/TB (powers of 1000) or
+    // KiB/MiB/GiB/TiB (powers of 1024), e.g. `64MiB`.
+    struct SizeKind {
+            using Native                             = std::uint64_t;
+            static constexpr ConfigValue::Type type  = ConfigValue::Type::Integer;
+            static constexpr const char *name        = "size";
+
+            static bool parse(std::string_view text, Native &out);
+            static std::string format(Native value);
+            static ConfigValue store(const std::string &raw, Native value);
+            static bool onStep(Native value, Native min, Native step);
+            static constexpr Native lowest() {
+                return 0;
+            }
+            // Sizes are kept in the signed integer of ConfigValue.
+            static constexpr Native highest() {
+                return static_cast<Native>(std::numeric_limits<std::int64_t>::max());
+            }
+    };
+
+    // Duration with a mandatory unit: ns, us, ms, s, min or h, e.g. `250ms`.
+    struct DurationKind {
+            using Native                             = std::chrono::nanoseconds;
+            static constexpr ConfigValue::Type type  = ConfigValue::Type::String;
+            static constexpr const char *name        = "duration";
+
+            static bool parse(std::string_view text, Native &out);
+            static std::string format(Native value);
+            static ConfigValue store(const std::string &raw, Native value);
+            static bool onStep(Native value, Native min, Native step);
+            static constexpr Native lowest() {
+                return Native::min();
+            }
+            static constexpr Native highest() {
+                return Native::max();
+            }
+    };
+
+    /*
+     * Numeric parameter with inclusive bounds and an optional step.
+     *
+     * The text is parsed once in set(), checked against [min, max] and, when
+     * `step` is not zero, against min + k * step; the native number is then
+     * stored in the ConfigValue of the base, so number() and as<T>() are plain
+     * member loads. Bounds are appended to the description. The raw text stays
+     * as written (`64MiB`), so a saved file keeps the user's units.
+     */
+    template <class Kind>
+    class ConfigNumber : public ConfigParameter {
+        public:
+            using Native = typename Kind::Native;
+
+            ConfigNumber(const std::string &name, const std::string &description, const std::string &value, Native min = Kind::lowest(),
+                         Native max = Kind::highest(), Native step = Native{});
+            ~ConfigNumber() override;
+            ConfigNumber(const ConfigNumber &rhs);
+            ConfigNumber(ConfigNumber &&rhs) noexcept;
+            ConfigNumber &operator=(const ConfigNumber &rhs);
+            ConfigNumber &operator=(ConfigNumber &&rhs) noexcept;
+            std::shared_ptr<ConfigParameter> clone() const override;
+            ConfigParameter *cloneInto(std::pmr::memory_resource &memory) const override;
+            void set(const std::string &val) override;
+
+            Native number() const;
+            Native min() const;
+            Native max() const;
+            Native step() const;
+
+        protected:
+            //
+        private:
+            static std::string describe(const std::string &description, Native min, Native max, Native step);
+            static ConfigValue parse(const std::string &name, const std::string &val, Native min, Native max, Native step, const char *what);
+
+            Native _min;
+            Native _max;
+            Native _step;
+    };
+
+    extern template class ConfigNumber<IntegerKind>;
+    extern template class ConfigNumber<FloatKind>;
+    extern template class ConfigNumber<SizeKind>;
+    extern template class ConfigNumber<DurationKind>;
+
+    using ConfigInteger  = ConfigNumber<IntegerKind>;
+    using ConfigFloat    = ConfigNumber<FloatKind>;
+    using ConfigSize     = ConfigNumber<SizeKind>;
+    using ConfigDuration = ConfigNumber<DurationKind>;
+}  // namespace cpp_config
+
+#endif
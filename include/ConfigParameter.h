@@ -15,6 +15,8 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
+#include <memory_resource>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -23,43 +25,49 @@
 #include <variant>
 #include <vector>
 
+#include "ConfigValue.h"
+
 namespace cpp_config {
 
     class ConfigParameter {
         public:
             ConfigParameter();
             ConfigParameter(const std::string &name, const std::string &description, const std::string &value);
+            ConfigParameter(const std::string &name, const std::string &description, const std::string &value, ConfigValue::Type type);
             virtual ~ConfigParameter();
             ConfigParameter(const ConfigParameter &rhs);
-            ConfigParameter(const ConfigParameter &&rhs);
+            ConfigParameter(ConfigParameter &&rhs) noexcept;
             ConfigParameter &operator=(const ConfigParameter &rhs);
-            ConfigParameter &operator=(const ConfigParameter &&rhs);
+            ConfigParameter &operator=(ConfigParameter &&rhs) noexcept;
 
-            const std::string name() const;  // cppcheck-suppress returnByReference
-            virtual const std::string description() const;
-            const std::string value() const;  // cppcheck-suppress returnByReference
+            // Accessors return references into the parameter and never allocate
+            const std::string &name() const;
+            virtual const std::string &description() const;
+            const std::string &value() const;
+            const ConfigValue &parsed() const;  // what as<T>() reads
+            ConfigValue::Type type() const;
+            virtual std::shared_ptr<ConfigParameter> clone() const;
+            virtual ConfigParameter *cloneInto(std::pmr::memory_resource &memory) const;
             virtual void set(const std::string &val);
+            // Takes a value that set() of this parameter produced before, e.g.
+            // read back from a binary cache, without parsing or checking it.
+            void restore(ConfigValue value);
             template <typename T>
             T as() const {
-                if constexpr (std::is_same_v<T, std::string>) {
-                    return _value;
-                } else if constexpr (std::is_same_v<T, bool>) {
-                    return "true" == _value;
-                } else if constexpr (std::is_integral_v<T>) {
-                    return static_cast<T>(std::stoll(_value));
-                } else if constexpr (std::is_floating_point_v<T>) {
-                    return static_cast<T>(std::stod(_value));
-                } else {
-                    throw std::invalid_argument("Unsupported type.");
-                }
+                return _value.template as<T>();
             }
 
         protected:
-            //
+            // For subclasses that parse the text themselves: `value` is taken
+            // as is, without checking it against `type`.
+            ConfigParameter(const std::string &name, const std::string &description, ConfigValue value, ConfigValue::Type type);
+            void assign(ConfigValue value);
+
         private:
             std::string _name;
             std::string _description;
-            std::string _value;
+            ConfigValue _value;
+            ConfigValue::Type _type;
     };
 }  // namespace cpp_config
 #endif
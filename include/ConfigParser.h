@@ -0,0 +1,199 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#ifndef CONFIGPARSER_H
+#define CONFIGPARSER_H
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "ConfigFile.h"
+
+namespace cpp_config {
+
+    /*
+     * Single-pass tokenizer for the configuration file format: `key = value`
+     * lines, optionally grouped under `[section]` headers (a subset of INI and
+     * TOML). Keys inside a section are reported with the section as prefix, so
+     * `port = 80` under `[server]` and a top-level `server.port = 80` both
+     * name the parameter registered as `server.port`.
+     *
+     *  - keys and values are trimmed; dotted keys may have quoted parts
+     *  - values may be "basic" (with \\ \" \n \t \r escapes) or 'literal'
+     *    strings; a bare value ends at a `#` or `;` preceded by whitespace
+     *  - `#` and `;` lines are comments; malformed lines are skipped, and so
+     *    are the entries under a malformed section header
+     *
+     * Malformed lines are passed to the optional `malformed()` callback of
+     * feed() and finish(); line(), column() and error() then tell where and
+     * why. Columns count bytes from 1.
+     *
+     * Input is fed in chunks of any size. Complete lines are tokenized in
+     * place; only a line split between two chunks is copied, so memory use
+     * depends on the longest line rather than the size of the file. The
+     * (name, value) views passed to the callback are valid during the call.
+     */
+    class IniTokenizer {
+        public:
+            enum class Line { Blank, Section, Entry, Malformed };
+
+            template <typename F>
+            void feed(std::string_view chunk, F &&f) {
+                feed(chunk, f, [] {});
+            }
+
+            template <typename F, typename E>
+            void feed(std::string_view chunk, F &&f, E &&malformed) {
+                std::size_t pos = 0;
+                if (!_carry.empty()) {
+                    std::size_t eol = chunk.find('\n');
+                    if (eol == std::string_view::npos) {
+                        _carry.append(chunk);
+                        return;
+                    }
+                    _carry.append(chunk.substr(0, eol));
+                    emit(_carry, f, malformed);
+                    _carry.clear();
+                    pos = eol + 1;
+                }
+                while (pos < chunk.size()) {
+                    std::size_t eol = chunk.find('\n', pos);
+                    if (eol == std::string_view::npos) {
+                        _carry.assign(chunk.substr(pos));
+                        return;
+                    }
+                    emit(chunk.substr(pos, eol - pos), f, malformed);
+                    pos = eol + 1;
+                }
+            }
+
+            // Tokenizes the last line if it has no newline and resets the
+            // tokenizer for the next input.
+            template <typename F>
+            void finish(F &&f) {
+                finish(f, [] {});
+            }
+
+            template <typename F, typename E>
+            void finish(F &&f, E &&malformed) {
+                if (!_carry.empty()) {
+                    emit(_carry, f, malformed);
+                    _carry.clear();
+                }
+                _section.clear();
+                _sectionValid = true;
+                _line         = 0;
+            }
+
+            // Number of the line reported last, starting at 1.
+            std::size_t line() const {
+                return _line;
+            }
+
+            // Column of the key of an Entry, or of the problem on a
+            // Malformed line.
+            std::size_t column() const {
+                return _column;
+            }
+
+            // Column of the value of an Entry.
+            std::size_t valueColumn() const {
+                return _valueColumn;
+            }
+
+            // Why the last line was Malformed.
+            const char *error() const {
+                return _error;
+            }
+
+            // Tokenizes one line without the trailing newline. For an Entry
+            // name() and value() hold the result until the next call.
+            Line parse(std::string_view line);
+
+            std::string_view name() const {
+                return _name;
+            }
+
+            std::string_view value() const {
+                return _value;
+            }
+
+        protected:
+            //
+        private:
+            std::string _section;       // qualified name of the current section
+            bool _sectionValid = true;  // false after a malformed header
+            std::string _carry;         // line split between two chunks
+            std::string _nameBuffer;    // qualified name when it is not a plain view
+            std::string _valueBuffer;   // unescaped basic string
+            std::string_view _name;
+            std::string_view _value;
+            std::size_t _line        = 0;
+            std::size_t _column      = 0;
+            std::size_t _valueColumn = 0;
+            const char *_error       = "";
+            const char *_origin      = nullptr;  // start of the line being parsed
+
+            template <typename F, typename E>
+            void emit(std::string_view line, F &f, E &malformed) {
+                ++_line;
+                switch (parse(line)) {
+                    case Line::Entry:
+                        f(_name, _value);
+                        break;
+                    case Line::Malformed:
+                        malformed();
+                        break;
+                    default:
+                        break;
+                }
+            }
+
+            static bool qualify(std::string_view key, std::string &out);
+            bool parseValue(std::string_view text);
+            Line fail(const char *at, const char *reason);
+    };
+
+    // Calls f(name, value) for every entry of `text`.
+    template <typename F>
+    void parseKeyValues(std::string_view text, F &&f) {
+        IniTokenizer tokenizer;
+        tokenizer.feed(text, f);
+        tokenizer.finish(f);
+    }
+
+    // Calls f(name, value) for every entry of the file at `path`, reading it
+    // in chunks, and malformed() for every malformed line; both may query
+    // `tokenizer` for the position. Returns false if the file cannot be opened.
+    template <typename F, typename E>
+    bool parseFile(const std::string &path, IniTokenizer &tokenizer, F &&f, E &&malformed) {
+        if (!readChunks(path, [&tokenizer, &f, &malformed](std::string_view chunk) { tokenizer.feed(chunk, f, malformed); })) {
+            return false;
+        }
+        tokenizer.finish(f, malformed);
+        return true;
+    }
+
+    template <typename F>
+    bool parseFile(const std::string &path, F &&f) {
+        IniTokenizer tokenizer;
+        return parseFile(path, tokenizer, f, [] {});
+    }
+
+    // Appends `value` in a form the tokenizer reads back unchanged: bare when
+    // possible, otherwise as an escaped basic string.
+    void appendValue(std::string &out, std::string_view value);
+
+};  // namespace cpp_config
+#endif
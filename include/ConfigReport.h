@@ -0,0 +1,89 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#ifndef CONFIGREPORT_H
+#define CONFIGREPORT_H
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "ConfigExceptions.h"
+
+namespace cpp_config {
+
+    // One problem found while loading a configuration file.
+    struct LoadIssue {
+            enum class Reason {
+                Malformed,     // the line could not be tokenized
+                UnknownKey,    // no parameter is registered under the name
+                InvalidValue,  // the parameter rejected the value
+                DuplicateKey,  // set again later in the file, this value is ignored
+            };
+
+            std::string source;  // file path
+            std::size_t line;    // from 1
+            std::size_t column;  // byte offset in the line, from 1
+            std::string key;     // empty for a malformed line
+            Reason reason;
+            std::string message;
+
+            // Unknown and duplicated keys are reported but never fail a load.
+            bool error() const {
+                return reason != Reason::UnknownKey && reason != Reason::DuplicateKey;
+            }
+    };
+
+    const char *toString(LoadIssue::Reason reason);
+
+    // Everything found wrong with a file, collected in the same pass that
+    // loads it.
+    class LoadReport {
+        public:
+            void add(LoadIssue issue);
+
+            const std::vector<LoadIssue> &issues() const;
+            std::size_t errors() const;
+            bool ok() const;
+
+            // One `path:line:column: reason: message` line per issue.
+            std::string toString() const;
+
+        protected:
+            //
+        private:
+            std::vector<LoadIssue> _issues;
+            std::size_t _errors = 0;
+    };
+
+    // How a load that found errors behaves.
+    enum class LoadMode {
+        Lenient,  // apply what is valid, skip the rest
+        Strict,   // publish nothing and throw ConfigLoadError
+    };
+
+    class ConfigLoadError : public ConfigurationError {
+        public:
+            explicit ConfigLoadError(LoadReport report);
+
+            const LoadReport &report() const;
+
+        protected:
+            //
+        private:
+            LoadReport _report;
+    };
+
+};  // namespace cpp_config
+
+#endif
@@ -0,0 +1,182 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#ifndef CONFIGSCHEMA_H
+#define CONFIGSCHEMA_H
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#include "ConfigExceptions.h"
+#include "ConfigFile.h"
+#include "ConfigNameIndex.h"
+#include "ConfigParser.h"
+#include "ConfigSnapshot.h"
+#include "ConfigValue.h"
+
+namespace cpp_config {
+
+    /*
+     * Compile-time description of one parameter. Specialize it for every
+     * enumerator used with StaticConfig:
+     *
+     *   template <>
+     *   struct cpp_config::ParamTraits<MyParams::Port> {
+     *       using type = int;
+     *       static constexpr std::string_view name        = "port";
+     *       static constexpr std::string_view description = "TCP server port";
+     *       static constexpr int defaultValue             = 8080;
+     *   };
+     *
+     * For std::string parameters defaultValue is a std::string_view.
+     */
+    template <auto Key>
+    struct ParamTraits;
+
+    /*
+     * Configuration whose parameters, names, types and defaults are all
+     * known at compile time.
+     *
+     * Values live in a std::tuple of their native types, defaults are taken
+     * from ParamTraits without any parsing, and get<Key>() resolves the tuple
+     * slot at compile time. Text is only parsed by loadFromFile(), where an
+     * invalid value throws ConfigurationError and nothing is applied. Reloads
+     * are published as immutable snapshots, like in Config.
+     */
+    template <class ParamsDict, ParamsDict... Keys>
+    class StaticConfig {
+        public:
+            using Values = std::tuple<typename ParamTraits<Keys>::type...>;
+
+            template <ParamsDict Key>
+            using type = typename ParamTraits<Key>::type;
+
+            class Snapshot : public std::enable_shared_from_this<Snapshot> {
+                public:
+                    Snapshot(Values values, std::uint64_t generation) : _values(std::move(values)), _generation(generation) {
+                    }
+
+                    template <ParamsDict Key>
+                    const type<Key> &get() const {
+                        return std::get<indexOf<Key>()>(_values);
+                    }
+
+                    const Values &values() const {
+                        return _values;
+                    }
+
+                    std::uint64_t generation() const {
+                        return _generation;
+                    }
+
+                private:
+                    Values _values;
+                    std::uint64_t _generation;
+            };
+
+            explicit StaticConfig(std::string confFileName)
+                : _confFileName(std::move(confFileName)), _names(namesMap()), _snapshot(std::make_shared<const Snapshot>(defaults(), 0)) {
+            }
+
+            // Returns a copy, so a std::string parameter allocates unless it
+            // fits the small string buffer. Reading it through a held
+            // snapshot() gives a reference instead, valid as long as the
+            // snapshot.
+            template <ParamsDict Key>
+            type<Key> get() const {
+                return _snapshot.read([](const Snapshot &snapshot) { return snapshot.template get<Key>(); });
+            }
+
+            // Consistent view of all parameters; get<Key>() on it is a plain member load.
+            std::shared_ptr<const Snapshot> snapshot() const {
+                return _snapshot.load();
+            }
+
+            template <ParamsDict Key>
+            static constexpr std::string_view name() {
+                return ParamTraits<Key>::name;
+            }
+
+            void loadFromFile() {
+                std::lock_guard<std::mutex> lock(_loadMutex);
+                std::shared_ptr<const Snapshot> current = _snapshot.load();
+                Values values                           = current->values();
+                bool opened = parseFile(_confFileName, [this, &values](std::string_view name, std::string_view value) {
+                    const std::size_t *index = _names.find(name);
+                    if (index != nullptr) {
+                        Setters[*index](values, name, value);
+                    }
+                });
+                if (!opened) {
+                    return;
+                }
+                _snapshot.store(std::make_shared<const Snapshot>(std::move(values), current->generation() + 1));
+            }
+
+        protected:
+            //
+        private:
+            using Setter = void (*)(Values &, std::string_view, std::string_view);
+
+            template <ParamsDict Key>
+            static constexpr std::size_t indexOf() {
+                constexpr std::array<ParamsDict, sizeof...(Keys)> keys{Keys...};
+                for (std::size_t i = 0; i < keys.size(); ++i) {
+                    if (keys[i] == Key) {
+                        return i;
+                    }
+                }
+                return keys.size();
+            }
+
+            template <std::size_t I>
+            static void set(Values &values, std::string_view name, std::string_view text) {
+                if (!parseStrict(text, std::get<I>(values))) {
+                    throw cpp_config::ConfigurationError("Value `" + std::string(text) + "` of `" + std::string(name) + "` has invalid type");
+                }
+            }
+
+            template <std::size_t... I>
+            static constexpr std::array<Setter, sizeof...(Keys)> makeSetters(std::index_sequence<I...>) {
+                return {&StaticConfig::set<I>...};
+            }
+
+            static constexpr std::array<Setter, sizeof...(Keys)> Setters = makeSetters(std::index_sequence_for<decltype(Keys)...>());
+
+            static Values defaults() {
+                return Values(type<Keys>(ParamTraits<Keys>::defaultValue)...);
+            }
+
+            static std::map<std::string_view, std::size_t> namesMap() {
+                std::map<std::string_view, std::size_t> names;
+                std::size_t index = 0;
+                ((names[ParamTraits<Keys>::name] = index++), ...);
+                return names;
+            }
+
+            std::string _confFileName;
+            NameIndex<std::size_t> _names;
+            AtomicSnapshot<Snapshot> _snapshot;
+            std::mutex _loadMutex;
+    };
+
+};  // namespace cpp_config
+#endif
@@ -0,0 +1,248 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#ifndef CONFIGSHARED_H
+#define CONFIGSHARED_H
+
+#pragma once
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Config.h"
+#include "ConfigStorage.h"
+#include "ConfigValue.h"
+
+namespace cpp_config {
+
+    /*
+     * POSIX shared memory segment holding a table of typed values.
+     *
+     * Layout, in 64-bit words:
+     *
+     *   header    magic, version, schema hash, slot count, text bytes
+     *   sequence  seqlock counter, odd while a write is in progress
+     *   slots     per value: integer, floating point bits, flags and text
+     *             length, text offset
+     *   text      raw values, packed into words
+     *
+     * One process creates the segment and writes it; any number of
+     * processes open it read-only. A read copies one slot and its text and
+     * retries if the sequence changed meanwhile, so it never blocks the
+     * writer and makes no system call. Every word is accessed atomically,
+     * which keeps the racing copies well defined, and ordered by release
+     * stores and acquire loads rather than fences, which ThreadSanitizer
+     * does not model. A writer that dies in the
+     * middle of a write leaves the sequence odd; readers then throw
+     * ConfigurationError once they waited longer than the write timeout.
+     */
+    class SharedSegment {
+        public:
+            static constexpr std::chrono::nanoseconds DefaultWriteTimeout = std::chrono::seconds(1);
+            static constexpr ::mode_t DefaultMode                         = 0600;
+
+            // Creates segment `name`, e.g. "/my-service.cfg", with permissions
+            // `mode`; the default lets only the owner's processes read it.
+            // Throws ConfigurationError if the name is taken, e.g. by a live
+            // publisher; see remove().
+            static SharedSegment create(const std::string &name, std::uint64_t schemaHash, std::size_t slots, std::size_t textBytes,
+                                        ::mode_t mode = DefaultMode);
+            // Maps an existing segment read-only; it has to match the schema.
+            // Reads give up after waiting `writeTimeout` for one write.
+            static SharedSegment open(const std::string &name, std::uint64_t schemaHash, std::size_t slots,
+                                      std::chrono::nanoseconds writeTimeout = DefaultWriteTimeout);
+
+            ~SharedSegment();
+            SharedSegment(SharedSegment &&rhs) noexcept;
+            SharedSegment &operator=(SharedSegment &&rhs) noexcept;
+            SharedSegment(const SharedSegment &)            = delete;
+            SharedSegment &operator=(const SharedSegment &) = delete;
+
+            // Writer side: replaces every slot, `values[i]` going to slot i.
+            // Throws ConfigurationError, before touching the segment, if the
+            // text does not fit.
+            void write(std::uint64_t generation, const std::vector<const ConfigValue *> &values);
+
+            // Reader side: consistent copy of one slot. Throws
+            // ConfigurationError if a write does not finish within the
+            // write timeout, e.g. because the writer died meanwhile.
+            ConfigValue read(std::size_t slot) const;
+            // Same as read() without the text, so nothing is allocated.
+            ConfigValue::Parsed parsed(std::size_t slot) const;
+            std::uint64_t generation() const;
+
+            const std::string &name() const;
+            std::size_t slots() const;
+
+            // Removes the name; existing mappings stay valid.
+            void unlink();
+            // Removes segment `name` left behind by a publisher that died.
+            // Processes still mapping it keep reading their copy.
+            static void remove(const std::string &name);
+
+        protected:
+            //
+        private:
+            SharedSegment(std::string name, std::uint64_t *words, std::size_t size, std::size_t slots, std::size_t textBytes, bool owner);
+
+            // Unmaps the segment and, for the owner, removes its name.
+            void release() noexcept;
+
+            std::uint64_t load(std::size_t word, std::memory_order order = std::memory_order_relaxed) const;
+            void store(std::size_t word, std::uint64_t value, std::memory_order order = std::memory_order_relaxed);
+
+            std::string _name;
+            std::uint64_t *_words;
+            std::size_t _size;  // of the mapping, in bytes
+            std::size_t _slots;
+            std::size_t _textBytes;
+            bool _owner;  // created the segment and unlinks it
+            std::chrono::nanoseconds _writeTimeout = DefaultWriteTimeout;  // of readers
+    };
+
+    // Number of slots a segment needs for `schema`.
+    template <class Schema>
+    std::size_t countParams(const Schema &schema) {
+        std::size_t count = 0;
+        schema.params().forEach([&count](const auto &, const auto &) { ++count; });
+        return count;
+    }
+
+    /*
+     * Publishes the parameters of a Config to a shared memory segment, so
+     * that other processes on the host read them without parsing the file.
+     *
+     * The segment is created with room for `textBytes` of raw values and
+     * filled from the current snapshot right away. publish() copies the
+     * snapshot again if its generation changed, e.g. after a reload; the
+     * publishing process keeps loading the file as before. Slots follow the
+     * key order of the schema, and readers refuse a segment written for a
+     * different schema. The segment is created with permissions `mode`, by
+     * default readable by the owner only, and a name that is already taken
+     * is an error. The segment name is removed when the publisher is
+     * destroyed.
+     */
+    template <class ParamsDict>
+    class SharedConfigPublisher {
+        public:
+            SharedConfigPublisher(const Config<ParamsDict> &config, const std::string &name, std::size_t textBytes = 64 * 1024,
+                                  ::mode_t mode = SharedSegment::DefaultMode)
+                : _config(config),
+                  _schema(config.schema()),
+                  _segment(SharedSegment::create(name, _schema->hash(), countParams(*_schema), textBytes, mode)),
+                  _published(0) {
+                write(*_config.snapshot());
+            }
+
+            // Copies the current snapshot into the segment unless it was
+            // already published. Returns whether anything was written.
+            bool publish() {
+                std::shared_ptr<const typename Config<ParamsDict>::Snapshot> snapshot = _config.snapshot();
+                if (snapshot->generation() == _published) {
+                    return false;
+                }
+                write(*snapshot);
+                return true;
+            }
+
+            const std::string &name() const {
+                return _segment.name();
+            }
+
+        protected:
+            //
+        private:
+            const Config<ParamsDict> &_config;
+            std::shared_ptr<const typename Config<ParamsDict>::Schema> _schema;
+            SharedSegment _segment;
+            std::uint64_t _published;
+
+            void write(const typename Config<ParamsDict>::Snapshot &snapshot) {
+                if (_config.schema()->hash() != _schema->hash()) {
+                    throw ConfigurationError("Parameters registered after `" + _segment.name() + "` was created cannot be published");
+                }
+                std::vector<const ConfigValue *> values;
+                values.reserve(_segment.slots());
+                snapshot.params().forEach([&values](const ParamsDict &, const auto &param) {
+                    values.push_back(&param->parsed());
+                });
+                _segment.write(snapshot.generation(), values);
+                _published = snapshot.generation();
+            }
+    };
+
+    /*
+     * Read-only view of a segment written by SharedConfigPublisher in
+     * another process. `schema` has to be the schema the publisher was
+     * built from. Reads convert like Config::value<T>() and make no system
+     * call; generation() tells when the publisher wrote a new snapshot.
+     * Reads and generation() throw ConfigurationError if the publisher
+     * leaves a write unfinished for longer than `writeTimeout`, which
+     * happens when it dies in the middle of one.
+     */
+    template <class ParamsDict>
+    class SharedConfigReader {
+        public:
+            SharedConfigReader(std::shared_ptr<const typename Config<ParamsDict>::Schema> schema, const std::string &name,
+                               std::chrono::nanoseconds writeTimeout = SharedSegment::DefaultWriteTimeout)
+                : _segment(SharedSegment::open(name, schema->hash(), countParams(*schema), writeTimeout)) {
+                std::size_t slot = 0;
+                schema->params().forEach([this, &slot](const ParamsDict &key, const auto &) {
+                    _slots.insert(key, slot++);
+                });
+            }
+
+            // Copy of one value, consistent in itself; values read one after
+            // another may come from different publications.
+            ConfigValue get(const ParamsDict &key) const {
+                return _segment.read(_slots.at(key));
+            }
+
+            // Only a std::string read copies the text; other types read the
+            // parsed words of the slot. The text is fetched just to report a
+            // value that does not convert.
+            template <typename T>
+            T value(const ParamsDict &key) const {
+                if constexpr (std::is_same_v<T, std::string>) {
+                    return get(key).raw();
+                } else {
+                    const ConfigValue value(std::string(), _segment.parsed(_slots.at(key)));
+                    try {
+                        return value.template as<T>();
+                    } catch (const std::logic_error &) {
+                        return get(key).template as<T>();
+                    }
+                }
+            }
+
+            std::uint64_t generation() const {
+                return _segment.generation();
+            }
+
+        protected:
+            //
+        private:
+            SharedSegment _segment;
+            ConfigStorage<ParamsDict, std::size_t> _slots;
+    };
+}  // namespace cpp_config
+
+#endif
@@ -0,0 +1,274 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#ifndef CONFIGSNAPSHOT_H
+#define CONFIGSNAPSHOT_H
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "ConfigArena.h"
+#include "ConfigParameter.h"
+#include "ConfigSources.h"
+#include "ConfigStorage.h"
+#include "ConfigStripe.h"
+
+namespace cpp_config {
+
+    /*
+     * Immutable view of every registered parameter at one point in time.
+     *
+     * Reloads never modify a published snapshot; they copy the table, replace
+     * the parameters that changed and publish the result as a new snapshot.
+     * Unchanged parameters are shared between consecutive snapshots.
+     *
+     * With ConfigArenaTraits enabled the parameters are plain pointers into
+     * the Config's ParameterArena; the snapshot then also keeps that arena
+     * alive, so it stays readable after Config::clear().
+     *
+     * The source of every value is kept in a separate table next to the
+     * parameters; reads never look at it.
+     */
+    template <class ParamsDict>
+    class ConfigSnapshot : public std::enable_shared_from_this<ConfigSnapshot<ParamsDict>> {
+        public:
+            using Handle  = ParameterHandle<ParamsDict>;
+            using Storage = ConfigStorage<ParamsDict, Handle>;
+            using Sources = ConfigStorage<ParamsDict, std::shared_ptr<const ValueSource>>;
+
+            ConfigSnapshot(Storage params, Sources sources, std::uint64_t generation, std::shared_ptr<const void> owner = nullptr)
+                : _params(std::move(params)), _sources(std::move(sources)), _generation(generation), _owner(std::move(owner)) {
+            }
+
+            const Handle &get(const ParamsDict &key) const {
+                return _params.at(key);
+            }
+
+            template <typename T>
+            T value(const ParamsDict &key) const {
+                return _params.at(key)->template as<T>();
+            }
+
+            const Storage &params() const {
+                return _params;
+            }
+
+            const ValueSource &source(const ParamsDict &key) const {
+                return *_sources.at(key);
+            }
+
+            const Sources &sources() const {
+                return _sources;
+            }
+
+            std::uint64_t generation() const {
+                return _generation;
+            }
+
+        protected:
+            //
+        private:
+            Storage _params;
+            Sources _sources;
+            std::uint64_t _generation;
+            std::shared_ptr<const void> _owner;  // arena the parameters live in, if any
+    };
+
+    /*
+     * Parameter returned by Config::get() with ConfigArenaTraits enabled,
+     * together with the snapshot it was read from.
+     *
+     * Arena objects are reclaimed with the last snapshot holding them, so
+     * holding the snapshot keeps the parameter readable across reloads,
+     * set(), compact() and clear(). Taking one costs a reference count on
+     * the snapshot; reads through it cost nothing further.
+     */
+    template <class ParamsDict>
+    class ParameterRef {
+        public:
+            ParameterRef(std::shared_ptr<const ConfigSnapshot<ParamsDict>> snapshot, const ConfigParameter &param)
+                : _snapshot(std::move(snapshot)), _param(&param) {
+            }
+
+            const ConfigParameter &operator*() const {
+                return *_param;
+            }
+
+            const ConfigParameter *operator->() const {
+                return _param;
+            }
+
+            const ConfigParameter *get() const {
+                return _param;
+            }
+
+            const ConfigSnapshot<ParamsDict> &snapshot() const {
+                return *_snapshot;
+            }
+
+        protected:
+            //
+        private:
+            std::shared_ptr<const ConfigSnapshot<ParamsDict>> _snapshot;
+            const ConfigParameter *_param;
+    };
+
+    /*
+     * Counts readers currently taking a reference in AtomicSnapshot.
+     *
+     * Readers register under the parity of the current epoch. advance()
+     * starts a new epoch once every reader of the previous one left; readers
+     * that arrive meanwhile register under the current parity and cannot
+     * hold it back. The counters are striped over cache lines so that
+     * concurrent readers on different threads do not keep bouncing a single
+     * line between cores.
+     */
+    class ReaderRegistry {
+        private:
+            struct alignas(64) Stripe {
+                    std::array<std::atomic<std::int64_t>, 2> readers{};
+            };
+
+        public:
+            class Guard {
+                public:
+                    explicit Guard(const ReaderRegistry &registry)
+                        : _readers(registry._stripes[threadStripe()].readers[registry._epoch.load(std::memory_order_seq_cst) & 1]) {
+                        _readers.fetch_add(1, std::memory_order_seq_cst);
+                    }
+                    ~Guard() {
+                        _readers.fetch_sub(1, std::memory_order_release);
+                    }
+                    Guard(const Guard &)            = delete;
+                    Guard &operator=(const Guard &) = delete;
+
+                private:
+                    std::atomic<std::int64_t> &_readers;
+            };
+
+            // Starts a new epoch if no reader of the previous one is left,
+            // i.e. every reader registered before the last advance() is gone.
+            bool advance() {
+                const std::uint64_t epoch = _epoch.load(std::memory_order_seq_cst);
+                for (const auto &stripe : _stripes) {
+                    if (stripe.readers[(epoch + 1) & 1].load(std::memory_order_seq_cst) != 0) {
+                        return false;
+                    }
+                }
+                _epoch.store(epoch + 1, std::memory_order_seq_cst);
+                return true;
+            }
+
+        protected:
+            //
+        private:
+            mutable std::array<Stripe, ThreadStripeCount> _stripes;
+            std::atomic<std::uint64_t> _epoch{0};
+    };
+
+    /*
+     * Single-writer publication point for immutable objects (RCU style).
+     *
+     * Every thread keeps the object it read last, with the version it was
+     * published under, in a small thread-local cache. read() and load()
+     * compare that version with the published one, a single atomic load,
+     * and only take a new reference after a store(). Taking one is
+     * lock-free: the reader registers, loads the current pointer and shares
+     * its ownership.
+     *
+     * store() swaps the pointer and retires the replaced object. Retired
+     * objects are released in batches, once every reader registered before
+     * the batch was closed has left, so readers that never pause do not
+     * hold them back. A thread's cache keeps its last object alive until
+     * that thread reads again or exits. The callback passed to read() must
+     * not read another AtomicSnapshot of the same type.
+     */
+    template <class T>
+    class AtomicSnapshot {
+        public:
+            explicit AtomicSnapshot(std::shared_ptr<const T> initial)
+                : _id(_instances.fetch_add(1, std::memory_order_relaxed)), _current(initial.get()), _version(0), _owned(std::move(initial)) {
+            }
+            AtomicSnapshot(const AtomicSnapshot &)            = delete;
+            AtomicSnapshot &operator=(const AtomicSnapshot &) = delete;
+
+            template <typename F>
+            decltype(auto) read(F &&f) const {
+                return std::forward<F>(f)(*cached().object);
+            }
+
+            std::shared_ptr<const T> load() const {
+                return cached().object;
+            }
+
+            void store(std::shared_ptr<const T> next) {
+                std::lock_guard<std::mutex> lock(_writeMutex);
+                _current.store(next.get(), std::memory_order_seq_cst);
+                // after the pointer, so a reader seeing the new version takes
+                // the new object
+                _version.fetch_add(1, std::memory_order_release);
+                _pending.push_back(std::move(_owned));
+                _owned = std::move(next);
+                if (_readers.advance()) {
+                    _waiting = std::move(_pending);
+                    _pending.clear();
+                }
+            }
+
+        protected:
+            //
+        private:
+            struct Entry {
+                    std::uint64_t id = 0;
+                    std::uint64_t version = 0;
+                    std::shared_ptr<const T> object;
+            };
+
+            static constexpr std::size_t CacheSize = 16;
+
+            static inline std::atomic<std::uint64_t> _instances{1};  // 0 marks an empty entry
+
+            const Entry &cached() const {
+                static thread_local std::array<Entry, CacheSize> cache;
+                Entry &entry                = cache[_id % CacheSize];
+                const std::uint64_t version = _version.load(std::memory_order_acquire);
+                if (entry.id != _id || entry.version != version) [[unlikely]] {
+                    ReaderRegistry::Guard guard(_readers);
+                    entry.object  = _current.load(std::memory_order_seq_cst)->shared_from_this();
+                    entry.id      = _id;
+                    entry.version = version;
+                }
+                return entry;
+            }
+
+            const std::uint64_t _id;
+            std::atomic<const T *> _current;
+            std::atomic<std::uint64_t> _version;
+            std::shared_ptr<const T> _owned;
+            // retired since the last advance(), and retired before it; the
+            // latter are released by the next advance()
+            std::vector<std::shared_ptr<const T>> _pending;
+            std::vector<std::shared_ptr<const T>> _waiting;
+            std::mutex _writeMutex;
+            ReaderRegistry _readers;
+    };
+
+};  // namespace cpp_config
+#endif
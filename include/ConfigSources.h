@@ -0,0 +1,94 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#ifndef CONFIGSOURCES_H
+#define CONFIGSOURCES_H
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace cpp_config {
+
+    // Where the current value of a parameter came from.
+    struct ValueSource {
+            enum class Kind {
+                Default,
+                File,
+                Environment,
+                CommandLine,
+                Runtime,  // Config::set()
+            };
+
+            Kind kind;
+            std::string name;  // file path, environment variable or option; empty otherwise
+
+            static const std::shared_ptr<const ValueSource> &defaults();
+            static const std::shared_ptr<const ValueSource> &runtime();
+    };
+
+    const char *toString(ValueSource::Kind kind);
+
+    /*
+     * Ordered list of layers for Config::load(). Later layers take
+     * precedence over earlier ones, and the built-in defaults come first:
+     *
+     *   ConfigSources()
+     *       .file("/etc/app.cfg")
+     *       .file("app.local.cfg", true)
+     *       .environment("APP_")
+     *       .commandLine(argc, argv);
+     */
+    class ConfigSources {
+        public:
+            struct Layer {
+                    ValueSource::Kind kind;
+                    std::string name;  // path, variable prefix or "command line"
+                    bool optional = false;
+                    std::vector<std::string> arguments;  // command line only, without the program name
+            };
+
+            // A missing file is an error unless `optional` is set.
+            ConfigSources &file(std::string path, bool optional = false);
+
+            // Parameter `server.port` is read from `<prefix>SERVER_PORT`.
+            ConfigSources &environment(std::string prefix);
+
+            // Accepts `--name=value`, `--name value` and `--name` (meaning
+            // "true"). A separate value is only taken for registered names,
+            // see options(). Other arguments, unknown names and everything
+            // after `--` are ignored.
+            ConfigSources &commandLine(int argc, const char *const argv[]);
+
+            const std::vector<Layer> &layers() const;
+
+            // Name and value pairs given by a command line layer. `--name`
+            // takes the next argument as its value only if `takesValue(name)`
+            // and that argument does not start with `--`, so a flag never
+            // swallows a positional argument that follows it.
+            static std::vector<std::pair<std::string, std::string>> options(const Layer &layer,
+                                                                            const std::function<bool(std::string_view)> &takesValue);
+
+            static std::string environmentName(std::string_view prefix, std::string_view name);
+
+        protected:
+            //
+        private:
+            std::vector<Layer> _layers;
+    };
+}  // namespace cpp_config
+
+#endif
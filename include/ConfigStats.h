@@ -0,0 +1,292 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#ifndef CONFIGSTATS_H
+#define CONFIGSTATS_H
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ConfigStorage.h"
+#include "ConfigStripe.h"
+
+namespace cpp_config {
+
+    /*
+     * Selects whether Config<ParamsDict> collects statistics: reads per
+     * parameter through get() and value<T>(), reload durations and problems
+     * found in loaded files. Disabled by default, in which case the counters
+     * are not even members of Config; specialize with `enabled = true`, or
+     * configure with -DCPP_CONFIG_ENABLE_STATS=ON to enable it for every Config.
+     */
+#ifdef CPP_CONFIG_ENABLE_STATS
+    inline constexpr bool StatsByDefault = true;
+#else
+    inline constexpr bool StatsByDefault = false;
+#endif
+
+    template <class ParamsDict>
+    struct ConfigStatsTraits {
+            static constexpr bool enabled = StatsByDefault;
+    };
+
+    // Copy of the counters of one Config, see Config::statistics().
+    struct ConfigStatistics {
+            static constexpr std::size_t ReloadBuckets = 12;
+
+            // Upper bounds of the reload duration buckets; the last bucket
+            // holds everything slower.
+            static const std::array<std::chrono::microseconds, ReloadBuckets - 1> &reloadBounds();
+
+            struct ParameterReads {
+                    std::string name;
+                    std::uint64_t count;
+            };
+
+            std::vector<ParameterReads> reads;  // in key order
+            std::uint64_t reloads        = 0;
+            std::uint64_t failedReloads  = 0;
+            std::uint64_t malformedLines = 0;
+            std::uint64_t unknownKeys    = 0;
+            std::uint64_t rejectedValues = 0;
+            std::array<std::uint64_t, ReloadBuckets> reloadHistogram{};
+            std::chrono::nanoseconds reloadTotal{0};
+            std::chrono::nanoseconds reloadMax{0};
+
+            // Human-readable dump, one counter per line.
+            std::string toString() const;
+
+            static std::size_t bucketOf(std::chrono::nanoseconds duration);
+    };
+
+    /*
+     * Counters behind ConfigStatistics.
+     *
+     * Reads only do a relaxed increment. Each thread counts into one of
+     * several stripes, each on its own cache lines, so threads reading the same
+     * parameter do not contend; the stripes are summed when statistics are
+     * collected. A new table of slots is made when newly registered
+     * parameters are frozen, sharing the counters of the previous one while
+     * they have room. Old tables are kept, because a reader may still be
+     * counting into one, and are summed as well.
+     */
+    template <class ParamsDict>
+    class ConfigStats {
+        public:
+            // Starts tracking the keys of `params`. Called by the writer once
+            // the registered keys are frozen. The current table is kept while
+            // it has a slot for every key. Otherwise the new table keeps the
+            // slots of the current one and shares its counters while they
+            // have room; when they do not, it gets at least twice as many, so
+            // all counters together stay within a small multiple of the last.
+            template <class Params>
+            void track(const Params &params) {
+                std::lock_guard<std::mutex> lock(_tablesMutex);
+                const Table *current = _current.load(std::memory_order_relaxed);
+                bool covered         = current != nullptr;
+                params.forEach([current, &covered](const ParamsDict &key, const auto &) {
+                    covered = covered && current->slots.contains(key);
+                });
+                if (covered) {
+                    return;
+                }
+
+                auto table = std::make_unique<Table>();
+                if (current != nullptr) {
+                    table->size = current->size;
+                    params.forEach([current, &table](const ParamsDict &key, const auto &) {
+                        table->slots.insert(key, current->slots.contains(key) ? current->slots.at(key) : table->size++);
+                    });
+                }
+                if (current != nullptr && table->size <= current->linesPerStripe * CountersPerLine) {
+                    table->linesPerStripe = current->linesPerStripe;
+                    table->lines          = current->lines;
+                } else {
+                    // counters of the slots dropped since are left behind
+                    table->slots.clear();
+                    table->size = 0;
+                    params.forEach([&table](const ParamsDict &key, const auto &) {
+                        table->slots.insert(key, table->size++);
+                    });
+                    table->linesPerStripe = (table->size + CountersPerLine - 1) / CountersPerLine;
+                    if (current != nullptr) {
+                        table->linesPerStripe = std::max(table->linesPerStripe, 2 * current->linesPerStripe);
+                    }
+                    table->lines = std::shared_ptr<Line[]>(new Line[table->linesPerStripe * StripeCount]);
+                }
+                _current.store(table.get(), std::memory_order_release);
+                _tables.push_back(std::move(table));
+            }
+
+            void countRead(const ParamsDict &key) const noexcept {
+                const Table *table = _current.load(std::memory_order_acquire);
+                if (table == nullptr || !table->slots.contains(key)) {
+                    return;
+                }
+                std::size_t slot = table->slots.at(key);
+                Line &line       = table->lines[threadStripe() * table->linesPerStripe + slot / CountersPerLine];
+                line.counters[slot % CountersPerLine].fetch_add(1, std::memory_order_relaxed);
+            }
+
+            void countMalformed() {
+                _malformedLines.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            void countUnknown() {
+                _unknownKeys.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            void countRejected() {
+                _rejectedValues.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            // Records the duration of a reload from construction to
+            // destruction; leaving by an exception counts as a failed reload.
+            class ReloadTimer {
+                public:
+                    explicit ReloadTimer(ConfigStats &stats)
+                        : _stats(stats), _start(std::chrono::steady_clock::now()), _exceptions(std::uncaught_exceptions()) {
+                    }
+                    ~ReloadTimer() {
+                        _stats.recordReload(std::chrono::steady_clock::now() - _start, std::uncaught_exceptions() > _exceptions);
+                    }
+                    ReloadTimer(const ReloadTimer &)            = delete;
+                    ReloadTimer &operator=(const ReloadTimer &) = delete;
+
+                protected:
+                    //
+                private:
+                    ConfigStats &_stats;
+                    std::chrono::steady_clock::time_point _start;
+                    int _exceptions;
+            };
+
+            // `params` names the keys to report reads for.
+            template <class Params>
+            ConfigStatistics collect(const Params &params) const {
+                ConfigStatistics result;
+                std::lock_guard<std::mutex> lock(_tablesMutex);
+                params.forEach([this, &result](const ParamsDict &key, const auto &param) {
+                    std::uint64_t count = 0;
+                    const Line *counted = nullptr;  // tables sharing counters are adjacent
+                    for (const auto &table : _tables) {
+                        if (table->slots.contains(key) && table->lines.get() != counted) {
+                            count += table->sum(table->slots.at(key));
+                            counted = table->lines.get();
+                        }
+                    }
+                    result.reads.push_back({param->name(), count});
+                });
+                result.reloads        = _reloads.load(std::memory_order_relaxed);
+                result.failedReloads  = _failedReloads.load(std::memory_order_relaxed);
+                result.malformedLines = _malformedLines.load(std::memory_order_relaxed);
+                result.unknownKeys    = _unknownKeys.load(std::memory_order_relaxed);
+                result.rejectedValues = _rejectedValues.load(std::memory_order_relaxed);
+                for (std::size_t i = 0; i < ConfigStatistics::ReloadBuckets; ++i) {
+                    result.reloadHistogram[i] = _reloadHistogram[i].load(std::memory_order_relaxed);
+                }
+                result.reloadTotal = std::chrono::nanoseconds(_reloadTotal.load(std::memory_order_relaxed));
+                result.reloadMax   = std::chrono::nanoseconds(_reloadMax.load(std::memory_order_relaxed));
+                return result;
+            }
+
+            // Zeroes every counter; counts racing with the call may survive it.
+            void reset() {
+                std::lock_guard<std::mutex> lock(_tablesMutex);
+                for (const auto &table : _tables) {
+                    for (std::size_t i = 0; i < table->linesPerStripe * StripeCount; ++i) {
+                        for (auto &counter : table->lines[i].counters) {
+                            counter.store(0, std::memory_order_relaxed);
+                        }
+                    }
+                }
+                for (auto *counter : {&_reloads, &_failedReloads, &_malformedLines, &_unknownKeys, &_rejectedValues, &_reloadTotal, &_reloadMax}) {
+                    counter->store(0, std::memory_order_relaxed);
+                }
+                for (auto &bucket : _reloadHistogram) {
+                    bucket.store(0, std::memory_order_relaxed);
+                }
+            }
+
+        protected:
+            //
+        private:
+            static constexpr std::size_t StripeCount     = ThreadStripeCount;
+            static constexpr std::size_t CountersPerLine = 8;
+
+            struct alignas(64) Line {
+                    std::array<std::atomic<std::uint64_t>, CountersPerLine> counters{};
+            };
+
+            struct Table {
+                    ConfigStorage<ParamsDict, std::size_t> slots;
+                    std::size_t size           = 0;
+                    std::size_t linesPerStripe = 0;
+                    std::shared_ptr<Line[]> lines;  // shared with the tables it grew from
+
+                    std::uint64_t sum(std::size_t slot) const {
+                        std::uint64_t total = 0;
+                        for (std::size_t stripe = 0; stripe < StripeCount; ++stripe) {
+                            total += lines[stripe * linesPerStripe + slot / CountersPerLine].counters[slot % CountersPerLine].load(std::memory_order_relaxed);
+                        }
+                        return total;
+                    }
+            };
+
+            void recordReload(std::chrono::nanoseconds duration, bool failed) {
+                auto nanos = static_cast<std::uint64_t>(duration.count());
+                _reloads.fetch_add(1, std::memory_order_relaxed);
+                if (failed) {
+                    _failedReloads.fetch_add(1, std::memory_order_relaxed);
+                }
+                _reloadHistogram[ConfigStatistics::bucketOf(duration)].fetch_add(1, std::memory_order_relaxed);
+                _reloadTotal.fetch_add(nanos, std::memory_order_relaxed);
+                std::uint64_t max = _reloadMax.load(std::memory_order_relaxed);
+                while (nanos > max && !_reloadMax.compare_exchange_weak(max, nanos, std::memory_order_relaxed)) {
+                }
+            }
+
+            std::atomic<const Table *> _current{nullptr};
+            std::vector<std::unique_ptr<Table>> _tables;
+            mutable std::mutex _tablesMutex;
+            std::atomic<std::uint64_t> _reloads{0};
+            std::atomic<std::uint64_t> _failedReloads{0};
+            std::atomic<std::uint64_t> _malformedLines{0};
+            std::atomic<std::uint64_t> _unknownKeys{0};
+            std::atomic<std::uint64_t> _rejectedValues{0};
+            std::array<std::atomic<std::uint64_t>, ConfigStatistics::ReloadBuckets> _reloadHistogram{};
+            std::atomic<std::uint64_t> _reloadTotal{0};
+            std::atomic<std::uint64_t> _reloadMax{0};
+    };
+
+    // Stand-in member and timer when statistics are compiled out.
+    struct NoStats {
+            struct ReloadTimer {
+                    explicit ReloadTimer(NoStats &) {
+                    }
+            };
+    };
+
+};  // namespace cpp_config
+
+#endif
@@ -0,0 +1,143 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#ifndef CONFIGSTORAGE_H
+#define CONFIGSTORAGE_H
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace cpp_config {
+
+    /*
+     * Selects how Config<ParamsDict> stores its parameters.
+     *
+     * Enums ending with a `Count` enumerator are stored in a flat array indexed
+     * by the enumerator value. Other enums can opt in by specializing this
+     * trait with `flat = true` and the array `size`; everything else falls back
+     * to a std::map, which suits sparse enums.
+     */
+    template <class ParamsDict>
+    struct ConfigStorageTraits {
+            static constexpr bool flat = false;
+    };
+
+    template <class ParamsDict>
+        requires std::is_enum_v<ParamsDict> && requires { ParamsDict::Count; }
+    struct ConfigStorageTraits<ParamsDict> {
+            static constexpr bool flat        = true;
+            static constexpr std::size_t size = static_cast<std::size_t>(ParamsDict::Count);
+    };
+
+    template <class ParamsDict, class Value>
+    class MapStorage {
+        public:
+            bool contains(const ParamsDict &key) const {
+                return _items.find(key) != _items.end();
+            }
+
+            const Value &at(const ParamsDict &key) const {
+                return _items.at(key);
+            }
+
+            void insert(const ParamsDict &key, Value value) {
+                _items[key] = std::move(value);
+            }
+
+            bool empty() const {
+                return _items.empty();
+            }
+
+            void clear() {
+                _items.clear();
+            }
+
+            template <typename F>
+            void forEach(F &&f) const {
+                for (const auto &[key, value] : _items) {
+                    f(key, value);
+                }
+            }
+
+        protected:
+            //
+        private:
+            std::map<ParamsDict, Value> _items;
+    };
+
+    template <class ParamsDict, class Value>
+    class FlatStorage {
+        public:
+            static constexpr std::size_t Size = ConfigStorageTraits<ParamsDict>::size;
+
+            bool contains(const ParamsDict &key) const {
+                std::size_t index = static_cast<std::size_t>(key);
+                return index < Size && _items[index].has_value();
+            }
+
+            const Value &at(const ParamsDict &key) const {
+                std::size_t index = static_cast<std::size_t>(key);
+                if (index >= Size || !_items[index].has_value()) [[unlikely]] {
+                    throw std::out_of_range("Parameter is not registered");
+                }
+                return *_items[index];
+            }
+
+            void insert(const ParamsDict &key, Value value) {
+                std::size_t index = static_cast<std::size_t>(key);
+                if (index >= Size) {
+                    throw std::out_of_range("Parameter key is outside of the flat storage");
+                }
+                _items[index] = std::move(value);
+            }
+
+            bool empty() const {
+                for (const auto &item : _items) {
+                    if (item.has_value()) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            void clear() {
+                for (auto &item : _items) {
+                    item.reset();
+                }
+            }
+
+            template <typename F>
+            void forEach(F &&f) const {
+                for (std::size_t index = 0; index < Size; ++index) {
+                    if (_items[index].has_value()) {
+                        f(static_cast<ParamsDict>(index), *_items[index]);
+                    }
+                }
+            }
+
+        protected:
+            //
+        private:
+            std::array<std::optional<Value>, Size> _items;
+    };
+
+    template <class ParamsDict, class Value>
+    using ConfigStorage = std::conditional_t<ConfigStorageTraits<ParamsDict>::flat, FlatStorage<ParamsDict, Value>, MapStorage<ParamsDict, Value>>;
+
+};  // namespace cpp_config
+#endif
@@ -0,0 +1,38 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#ifndef CONFIGSTRIPE_H
+#define CONFIGSTRIPE_H
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <thread>
+
+namespace cpp_config {
+
+    /*
+     * Number of stripes that per-thread counters are spread over.
+     *
+     * ReaderRegistry and ConfigStats keep one cache line of counters per
+     * stripe so that threads on different cores rarely write the same line.
+     */
+    inline constexpr std::size_t ThreadStripeCount = 16;
+
+    // Stripe of the calling thread, computed once per thread.
+    inline std::size_t threadStripe() {
+        static thread_local const std::size_t index = std::hash<std::thread::id>{}(std::this_thread::get_id()) % ThreadStripeCount;
+        return index;
+    }
+
+};  // namespace cpp_config
+#endif
@@ -0,0 +1,104 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#ifndef CONFIGTHREADPOOL_H
+#define CONFIGTHREADPOOL_H
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cpp_config {
+
+    /*
+     * Fixed set of worker threads running index ranges in parallel.
+     *
+     * parallelFor() splits the indices into one contiguous block per worker.
+     * A worker takes work from the back of its own queue and, once that is
+     * empty, steals from the front of the others, so a few expensive items
+     * do not leave the rest of the pool idle. Batches run one at a time.
+     * Idle workers and the waiting caller block on atomic waits.
+     */
+    class WorkStealingPool {
+        public:
+            // 0 picks std::thread::hardware_concurrency()
+            explicit WorkStealingPool(std::size_t threads = 0);
+            ~WorkStealingPool();
+            WorkStealingPool(const WorkStealingPool &)            = delete;
+            WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+            std::size_t size() const;
+
+            // Calls task(i) for every i in [0, count) and returns once all calls
+            // finished. The first exception thrown by a task is rethrown here
+            // after the whole batch ran.
+            void parallelFor(std::size_t count, const std::function<void(std::size_t)> &task);
+
+        protected:
+            //
+        private:
+            struct alignas(64) Queue {
+                    std::mutex mutex;
+                    std::deque<std::size_t> items;
+            };
+
+            void work(std::size_t self);
+            bool next(std::size_t self, std::size_t &index);
+
+            std::vector<std::unique_ptr<Queue>> _queues;
+            std::vector<std::thread> _threads;
+            std::mutex _batchMutex;  // one parallelFor() at a time
+            std::atomic<std::uint64_t> _generation{0};  // bumped to wake the workers
+            std::atomic<bool> _stop{false};
+            std::atomic<const std::function<void(std::size_t)> *> _task{nullptr};
+            std::atomic<std::size_t> _remaining{0};
+            std::mutex _errorMutex;
+            std::exception_ptr _error;
+    };
+
+    /*
+     * One worker thread running posted tasks in the order they were posted.
+     * post() only queues the task and never waits for the worker. The
+     * destructor runs the tasks still queued, then joins. Tasks must not
+     * throw.
+     */
+    class SerialExecutor {
+        public:
+            SerialExecutor();
+            ~SerialExecutor();
+            SerialExecutor(const SerialExecutor &)            = delete;
+            SerialExecutor &operator=(const SerialExecutor &) = delete;
+
+            void post(std::function<void()> task);
+
+        protected:
+            //
+        private:
+            void work();
+
+            std::mutex _mutex;
+            std::deque<std::function<void()>> _tasks;
+            std::atomic<std::uint64_t> _posted{0};  // bumped to wake the worker
+            std::atomic<bool> _stop{false};
+            std::thread _thread;  // last, so it starts once the rest exists
+    };
+}  // namespace cpp_config
+
+#endif
@@ -0,0 +1,166 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#ifndef CONFIGVALUE_H
+#define CONFIGVALUE_H
+
+#pragma once
+
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace cpp_config {
+
+    /*
+     * Raw parameter text together with its typed interpretations.
+     *
+     * The text is parsed once on construction, so as<T>() is a plain member
+     * load instead of a std::stoll / std::stod call on every read. Typed
+     * parameters that parse the text themselves construct the value from the
+     * native number instead, and ConfigChoice adds the position of the value
+     * in its list, which as<Enum>() returns. Integral reads that do not fit
+     * the requested type throw std::out_of_range rather than truncate; a type
+     * that cannot be read at all throws std::invalid_argument.
+     */
+    class ConfigValue {
+        public:
+            enum class Type { String, Bool, Integer, Floating };
+
+            // Typed interpretations without the text, for copying a value to
+            // memory shared with other processes.
+            struct Parsed {
+                    std::int64_t integer;
+                    double floating;
+                    bool boolean;
+                    std::uint8_t flags;
+                    std::uint32_t choice;
+            };
+
+            // Position of the text in the list of a ConfigChoice.
+            struct Choice {
+                    std::uint32_t index;
+            };
+
+            ConfigValue();
+            explicit ConfigValue(const std::string &raw);
+            ConfigValue(const std::string &raw, std::int64_t integer);
+            ConfigValue(const std::string &raw, double floating);
+            ConfigValue(const std::string &raw, std::chrono::nanoseconds duration);
+            ConfigValue(const std::string &raw, const Parsed &parsed);
+            ConfigValue(const std::string &raw, Choice choice);
+
+            const std::string &raw() const;
+            bool holds(Type type) const;
+            Parsed parsed() const;
+            // Position in the list of a ConfigChoice.
+            std::uint32_t choice() const {
+                return _choice;
+            }
+
+            template <typename T>
+            T as() const {
+                if constexpr (std::is_same_v<T, std::string>) {
+                    return _raw;
+                } else if constexpr (std::is_same_v<T, bool>) {
+                    return _boolean;
+                } else if constexpr (IsDuration<T>::value) {
+                    if (!(_flags & DurationFlag)) {
+                        throw std::invalid_argument("Value `" + _raw + "` is not a duration.");
+                    }
+                    return std::chrono::duration_cast<T>(std::chrono::nanoseconds(_integer));
+                } else if constexpr (std::is_integral_v<T>) {
+                    if (!(_flags & IntegerFlag)) {
+                        throw std::invalid_argument("Value `" + _raw + "` is not an integer.");
+                    }
+                    if (!std::in_range<T>(_integer)) {
+                        throw std::out_of_range("Value `" + _raw + "` does not fit the requested type.");
+                    }
+                    return static_cast<T>(_integer);
+                } else if constexpr (std::is_floating_point_v<T>) {
+                    if (!(_flags & FloatingFlag)) {
+                        throw std::invalid_argument("Value `" + _raw + "` is not a floating point number.");
+                    }
+                    return static_cast<T>(_floating);
+                } else if constexpr (std::is_enum_v<T>) {
+                    if (!(_flags & ChoiceFlag)) {
+                        throw std::invalid_argument("Value `" + _raw + "` is not a choice.");
+                    }
+                    return static_cast<T>(_choice);
+                } else {
+                    throw std::invalid_argument("Unsupported type.");
+                }
+            }
+
+        protected:
+            //
+        private:
+            enum Flags : std::uint8_t {
+                IntegerFlag       = 1 << 0,
+                FloatingFlag      = 1 << 1,
+                ExactIntegerFlag  = 1 << 2,
+                ExactFloatingFlag = 1 << 3,
+                DurationFlag      = 1 << 4,  // _integer counts nanoseconds
+                ChoiceFlag        = 1 << 5,  // _choice holds the position in the list
+            };
+
+            template <typename T>
+            struct IsDuration : std::false_type {};
+            template <typename Rep, typename Period>
+            struct IsDuration<std::chrono::duration<Rep, Period>> : std::true_type {};
+
+            std::string _raw;
+            std::int64_t _integer;
+            double _floating;
+            bool _boolean;
+            std::uint8_t _flags;
+            std::uint32_t _choice;
+    };
+
+    const char *toString(ConfigValue::Type type);
+
+    /*
+     * Strict conversion to a native type: the whole text has to be a valid T
+     * (`true`/`false` for bool, std::from_chars syntax for numbers, no
+     * overflow). Returns false and leaves `out` untouched otherwise.
+     */
+    template <typename T>
+    bool parseStrict(std::string_view text, T &out) {
+        if constexpr (std::is_same_v<T, std::string>) {
+            out.assign(text);
+            return true;
+        } else if constexpr (std::is_same_v<T, bool>) {
+            if (text == "true" || text == "false") {
+                out = text == "true";
+                return true;
+            }
+            return false;
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            T value{};
+            auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+            if (ec != std::errc() || ptr != text.data() + text.size() || text.empty()) {
+                return false;
+            }
+            out = value;
+            return true;
+        } else {
+            static_assert(std::is_same_v<T, std::string>, "Unsupported parameter type.");
+            return false;
+        }
+    }
+}  // namespace cpp_config
+#endif
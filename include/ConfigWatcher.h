@@ -0,0 +1,54 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#ifndef CONFIGWATCHER_H
+#define CONFIGWATCHER_H
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace cpp_config {
+
+    /*
+     * Background watcher for a single file (inotify on Linux).
+     *
+     * The parent directory is watched rather than the file itself so that
+     * editors replacing the file through a rename are noticed as well. A burst
+     * of events is collapsed into one callback fired once the file has been
+     * quiet for the debounce interval. The callback runs on the watcher thread.
+     */
+    class FileWatcher {
+        public:
+            FileWatcher(const std::string &path, std::chrono::milliseconds debounce, std::function<void()> onChange);
+            ~FileWatcher();
+            FileWatcher(const FileWatcher &rhs)            = delete;
+            FileWatcher &operator=(const FileWatcher &rhs) = delete;
+
+        protected:
+            //
+        private:
+            void run();
+
+            std::string _directory;
+            std::string _fileName;
+            std::chrono::milliseconds _debounce;
+            std::function<void()> _onChange;
+            int _inotifyFd;
+            int _stopFd;
+            std::thread _thread;
+    };
+}  // namespace cpp_config
+
+#endif
@@ -0,0 +1,111 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#include "ConfigArena.h"
+
+#include <algorithm>
+
+namespace cpp_config {
+
+    ParameterArena::Recorder::Recorder(std::pmr::memory_resource &upstream) : block(nullptr), bytes(0), alignment(0), _upstream(upstream) {
+    }
+
+    void *ParameterArena::Recorder::do_allocate(std::size_t bytes, std::size_t alignment) {
+        this->block     = _upstream.allocate(bytes, alignment);
+        this->bytes     = bytes;
+        this->alignment = alignment;
+        return this->block;
+    }
+
+    void ParameterArena::Recorder::do_deallocate(void *block, std::size_t bytes, std::size_t alignment) {
+        _upstream.deallocate(block, bytes, alignment);
+    }
+
+    bool ParameterArena::Recorder::do_is_equal(const std::pmr::memory_resource &other) const noexcept {
+        return this == &other;
+    }
+
+    ParameterArena::ParameterArena() {
+    }
+
+    ParameterArena::~ParameterArena() {
+        // the memory itself goes away with _memory
+        for (auto &[_, object] : _objects) {
+            object.object->~ConfigParameter();
+        }
+    }
+
+    ConfigParameter *ParameterArena::clone(const ConfigParameter &param) {
+        // make room first, so that a copied object is never left untracked
+        _objects.reserve(_objects.size() + 1);
+        Recorder recorder(_memory);
+        ConfigParameter *copy = param.cloneInto(recorder);
+        // not published yet, so any snapshot may still be holding it
+        _objects.emplace(copy, Object{copy, recorder.block, recorder.bytes, recorder.alignment, 0, 0});
+        return copy;
+    }
+
+    void ParameterArena::destroy(const ConfigParameter *param) {
+        auto it = _objects.find(param);
+        if (it != _objects.end()) {
+            release(it);
+        }
+    }
+
+    void ParameterArena::published(std::uint64_t generation, std::weak_ptr<const void> snapshot, const std::vector<const ConfigParameter *> &added,
+                                   const std::vector<const ConfigParameter *> &replaced) {
+        _snapshots.push_back({generation, std::move(snapshot)});
+        for (const ConfigParameter *param : added) {
+            auto it = _objects.find(param);
+            if (it != _objects.end()) {
+                it->second.added = generation;
+            }
+        }
+        _replaced.reserve(_replaced.size() + replaced.size());
+        for (const ConfigParameter *param : replaced) {
+            auto it = _objects.find(param);
+            if (it != _objects.end()) {
+                it->second.replaced = generation;
+                _replaced.push_back(param);
+            }
+        }
+    }
+
+    std::size_t ParameterArena::reclaim() {
+        std::erase_if(_snapshots, [](const Published &published) { return published.snapshot.expired(); });
+        std::size_t released = 0;
+        std::erase_if(_replaced, [this, &released](const ConfigParameter *param) {
+            auto it = _objects.find(param);
+            // alive snapshots published between adding and replacing it
+            auto holder = std::lower_bound(_snapshots.begin(), _snapshots.end(), it->second.added,
+                                           [](const Published &published, std::uint64_t generation) { return published.generation < generation; });
+            if (holder != _snapshots.end() && holder->generation < it->second.replaced) {
+                return false;
+            }
+            release(it);
+            ++released;
+            return true;
+        });
+        return released;
+    }
+
+    std::size_t ParameterArena::size() const {
+        return _objects.size();
+    }
+
+    void ParameterArena::release(std::unordered_map<const ConfigParameter *, Object>::iterator it) {
+        const Object object = it->second;
+        object.object->~ConfigParameter();
+        _objects.erase(it);
+        _memory.deallocate(object.block, object.bytes, object.alignment);
+    }
+
+}  // namespace cpp_config
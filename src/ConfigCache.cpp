@@ -0,0 +1,155 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#include "ConfigCache.h"
+
+#include <sys/stat.h>
+
+#include <chrono>
+#include <cstring>
+
+namespace cpp_config {
+
+    namespace {
+        constexpr char Magic[8] = "CPPCFGB";
+
+        struct Header {
+                char magic[8];
+                std::uint32_t version;
+                std::uint32_t count;
+                std::uint64_t schemaHash;
+                std::uint64_t sourceSize;
+                std::int64_t sourceMtimeNs;
+                std::uint64_t sourceContent;
+        };
+
+        // Smallest serialized entry: key, parsed value and length of an empty raw text.
+        constexpr std::size_t MinEntryBytes = sizeof(std::int64_t) + sizeof(std::int64_t) + sizeof(double) + 2 * sizeof(std::uint8_t) +
+                                              2 * sizeof(std::uint32_t);
+
+        template <typename T>
+        bool readPod(std::string_view data, std::size_t &pos, T &out) {
+            if (data.size() - pos < sizeof(T)) {
+                return false;
+            }
+            std::memcpy(&out, data.data() + pos, sizeof(T));
+            pos += sizeof(T);
+            return true;
+        }
+
+        template <typename T>
+        void appendPod(std::string &out, const T &value) {
+            out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+    }  // namespace
+
+    SourceStamp SourceStamp::of(const std::string &path) {
+        SourceStamp stamp;
+        struct stat info;
+        if (::stat(path.c_str(), &info) == 0) {
+            stamp.size    = static_cast<std::uint64_t>(info.st_size);
+            stamp.mtimeNs = static_cast<std::int64_t>(info.st_mtim.tv_sec) * 1000000000LL + info.st_mtim.tv_nsec;
+            stamp.exists  = true;
+        }
+        return stamp;
+    }
+
+    // Two seconds cover the coarsest common timestamps (FAT).
+    bool SourceStamp::settled() const {
+        const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch());
+        return exists && mtimeNs < (now - std::chrono::seconds(2)).count();
+    }
+
+    BinaryCache::BinaryCache(const std::string &path, std::uint64_t schemaHash) : _file(path), _valid(false), _content(0) {
+        if (!_file.is_open()) {
+            return;
+        }
+
+        std::string_view data = _file.content();
+        std::size_t pos       = 0;
+        Header header;
+        if (!readPod(data, pos, header) || std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version ||
+            header.schemaHash != schemaHash) {
+            return;
+        }
+        if (header.sourceMtimeNs != 0) {
+            _source = SourceStamp{header.sourceSize, header.sourceMtimeNs, true};
+        }
+        _content = header.sourceContent;
+
+        // a corrupt or truncated file cannot hold the entries it claims
+        if (header.count > (data.size() - pos) / MinEntryBytes) {
+            return;
+        }
+        _entries.reserve(header.count);
+        for (std::uint32_t i = 0; i < header.count; ++i) {
+            Entry entry{};
+            std::uint32_t length;
+            if (!readPod(data, pos, entry.key) || !readPod(data, pos, entry.parsed.integer) || !readPod(data, pos, entry.parsed.floating) ||
+                !readPod(data, pos, entry.parsed.boolean) || !readPod(data, pos, entry.parsed.flags) || !readPod(data, pos, entry.parsed.choice) ||
+                !readPod(data, pos, length) || data.size() - pos < length) {
+                _entries.clear();
+                return;
+            }
+            entry.raw = data.substr(pos, length);
+            _entries.push_back(entry);
+            pos += length;
+        }
+        _valid = pos == data.size();
+    }
+
+    bool BinaryCache::valid() const {
+        return _valid;
+    }
+
+    bool BinaryCache::builtFrom(const SourceStamp &source) const {
+        return _valid && _source.exists && _source == source;
+    }
+
+    bool BinaryCache::builtFrom(std::uint64_t content) const {
+        return _valid && _content == content;
+    }
+
+    const std::vector<BinaryCache::Entry> &BinaryCache::entries() const {
+        return _entries;
+    }
+
+    void BinaryCache::write(const std::string &path, std::uint64_t schemaHash, const SourceStamp &source, std::uint64_t content,
+                            const std::vector<Entry> &entries) {
+        Header header{};
+        std::memcpy(header.magic, Magic, sizeof(Magic));
+        header.version    = Version;
+        header.count      = static_cast<std::uint32_t>(entries.size());
+        header.schemaHash = schemaHash;
+        // a source written again within the same timestamp tick would keep
+        // its size and mtime, so only a settled one is trusted by them
+        if (source.settled()) {
+            header.sourceSize    = source.size;
+            header.sourceMtimeNs = source.mtimeNs;
+        }
+        header.sourceContent = content;
+
+        std::string out;
+        appendPod(out, header);
+        for (const auto &entry : entries) {
+            appendPod(out, entry.key);
+            appendPod(out, entry.parsed.integer);
+            appendPod(out, entry.parsed.floating);
+            appendPod(out, entry.parsed.boolean);
+            appendPod(out, entry.parsed.flags);
+            appendPod(out, entry.parsed.choice);
+            appendPod(out, static_cast<std::uint32_t>(entry.raw.size()));
+            out.append(entry.raw);
+        }
+        writeFileAtomically(path, out);
+    }
+
+}  // namespace cpp_config
@@ -11,54 +11,98 @@
 
 #include "ConfigChoice.h"
 
-#include <algorithm>
+#include <sstream>
 #include <utility>
 
 #include "ConfigExceptions.h"
 
 namespace cpp_config {
-    ConfigChoice::ConfigChoice() : ConfigParameter() {
+    namespace {
+        std::vector<std::pair<std::string_view, std::size_t>> positions(const std::vector<std::string> &values) {
+            std::vector<std::pair<std::string_view, std::size_t>> result;
+            result.reserve(values.size());
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                result.emplace_back(values[i], i);
+            }
+            return result;
+        }
+    }  // namespace
+
+    ConfigChoice::Choices::Choices(const std::string &summary, std::vector<std::string> list) : values(std::move(list)), index(positions(values)) {
+        parsed.reserve(values.size());
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            parsed.emplace_back(values[i], ConfigValue::Choice{static_cast<std::uint32_t>(i)});
+        }
+        std::stringstream ss;
+        ss << summary << "; /";
+        for (const auto &c : values) {
+            ss << c << "/";
+        }
+        description = ss.str();
+    }
+
+    ConfigChoice::ConfigChoice() : ConfigParameter(), _choices(std::make_shared<const Choices>(ConfigParameter::description(), std::vector<std::string>{})) {
     }
     ConfigChoice::ConfigChoice(const std::string &name, const std::string &description, const std::string &value, const std::vector<std::string> &choice)
-        : ConfigParameter(name, description, value), _choice(choice) {
+        : ConfigParameter(name, description, value), _choices(std::make_shared<const Choices>(description, choice)) {
+        const std::size_t *pos = _choices->index.find(value);
+        if (pos == nullptr) {
+            throw cpp_config::ConfigurationError("Default value `" + value + "` of `" + name + "` is not on allowed list");
+        }
+        assign(_choices->parsed[*pos]);
     }
     ConfigChoice::~ConfigChoice() {
     }
-    ConfigChoice::ConfigChoice(const ConfigChoice &rhs) : ConfigParameter(rhs), _choice(rhs._choice) {
+    ConfigChoice::ConfigChoice(const ConfigChoice &rhs) : ConfigParameter(rhs), _choices(rhs._choices) {
     }
-    ConfigChoice::ConfigChoice(const ConfigChoice &&rhs) : ConfigParameter(std::move(rhs)), _choice(std::move(rhs._choice)) {
+    // The interned table is immutable and shared, so the moved-from object keeps
+    // its pointer and stays usable; only the strings in the base are moved.
+    ConfigChoice::ConfigChoice(ConfigChoice &&rhs) noexcept : ConfigParameter(std::move(rhs)), _choices(rhs._choices) {
     }
     ConfigChoice &ConfigChoice::operator=(const ConfigChoice &rhs) {
         if (this != &rhs) {
             ConfigParameter::operator=(rhs);
-            _choice = rhs._choice;
+            _choices = rhs._choices;
         }
         return *this;
     }
-    ConfigChoice &ConfigChoice::operator=(const ConfigChoice &&rhs) {
+    ConfigChoice &ConfigChoice::operator=(ConfigChoice &&rhs) noexcept {
         if (this != &rhs) {
             ConfigParameter::operator=(std::move(rhs));
-            _choice = std::move(rhs._choice);
+            _choices = rhs._choices;
         }
         return *this;
     }
+    std::shared_ptr<ConfigParameter> ConfigChoice::clone() const {
+        return std::make_shared<ConfigChoice>(*this);
+    }
+    ConfigParameter *ConfigChoice::cloneInto(std::pmr::memory_resource &memory) const {
+        return std::pmr::polymorphic_allocator<>(&memory).new_object<ConfigChoice>(*this);
+    }
     void ConfigChoice::set(const std::string &val) {
-        auto f = std::find(_choice.begin(), _choice.end(), val);
-        if (f == _choice.end()) {
-            std::stringstream ss;
-            ss << "Value `" << val << "` is not on allowed list";
-
-            throw cpp_config::ConfigurationError(ss.str());
+        const std::size_t *pos = _choices->index.find(val);
+        if (pos == nullptr) {
+            throw cpp_config::ConfigurationError("Value `" + val + "` is not on allowed list");
         }
-        ConfigParameter::set(val);
+        assign(_choices->parsed[*pos]);
     }
 
-    const std::string ConfigChoice::description() const {
-        std::stringstream ss;
-        ss << ConfigParameter::description() << "; /";
-        for (const auto &c : _choice) {
-            ss << c << "/";
+    const std::string &ConfigChoice::description() const {
+        return _choices->description;
+    }
+
+    std::size_t ConfigChoice::index() const {
+        return parsed().choice();
+    }
+
+    std::string_view ConfigChoice::choice() const {
+        if (_choices->values.empty()) {
+            return {};
         }
-        return ss.str();
+        return _choices->values[index()];
+    }
+
+    const std::vector<std::string> &ConfigChoice::choices() const {
+        return _choices->values;
     }
 }  // namespace cpp_config
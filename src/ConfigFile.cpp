@@ -0,0 +1,159 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#include "ConfigFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "ConfigExceptions.h"
+
+namespace cpp_config {
+
+    MappedFile::MappedFile(const std::string &path) : _open(false), _mapping(nullptr), _size(0) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+            _size = static_cast<std::size_t>(info.st_size);
+            if (_size >= MapThreshold) {
+                void *mapping = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapping != MAP_FAILED) {
+                    madvise(mapping, _size, MADV_SEQUENTIAL);
+                    _mapping = mapping;
+                    _open    = true;
+                }
+            }
+            if (!_open) {
+                _buffer.resize(_size);
+                std::size_t done = 0;
+                while (done < _size) {
+                    ssize_t chunk = ::read(fd, _buffer.data() + done, _size - done);
+                    if (chunk < 0 && errno == EINTR) {
+                        continue;
+                    }
+                    if (chunk <= 0) {
+                        break;
+                    }
+                    done += static_cast<std::size_t>(chunk);
+                }
+                // the file may have shrunk since fstat()
+                _buffer.resize(done);
+                _size = done;
+                _open = true;
+            }
+        }
+        ::close(fd);
+    }
+
+    MappedFile::~MappedFile() {
+        if (_mapping != nullptr) {
+            munmap(_mapping, _size);
+        }
+    }
+
+    bool MappedFile::is_open() const {
+        return _open;
+    }
+
+    bool MappedFile::mapped() const {
+        return _mapping != nullptr;
+    }
+
+    std::string_view MappedFile::content() const {
+        if (_mapping != nullptr) {
+            return std::string_view(static_cast<const char *>(_mapping), _size);
+        }
+        return _buffer;
+    }
+
+    bool readChunks(const std::string &path, const std::function<void(std::string_view)> &f, std::size_t chunkSize) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+        std::vector<char> buffer(chunkSize);
+        try {
+            while (true) {
+                ssize_t chunk = ::read(fd, buffer.data(), buffer.size());
+                if (chunk < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (chunk <= 0) {
+                    break;
+                }
+                f(std::string_view(buffer.data(), static_cast<std::size_t>(chunk)));
+            }
+        } catch (...) {
+            ::close(fd);
+            throw;
+        }
+        ::close(fd);
+        return true;
+    }
+
+    void writeFileAtomically(const std::string &path, std::string_view content) {
+        std::string tmpl = path + ".tmp.XXXXXX";
+        std::vector<char> tmpPath(tmpl.begin(), tmpl.end());
+        tmpPath.push_back('\0');
+
+        int fd = mkstemp(tmpPath.data());
+        if (fd < 0) {
+            throw cpp_config::ConfigurationError("Cannot create temporary file for `" + path + "`: " + std::strerror(errno));
+        }
+
+        std::size_t done = 0;
+        while (done < content.size()) {
+            ssize_t chunk = ::write(fd, content.data() + done, content.size() - done);
+            if (chunk < 0 && errno == EINTR) {
+                continue;
+            }
+            if (chunk < 0) {
+                break;
+            }
+            done += static_cast<std::size_t>(chunk);
+        }
+
+        // Keep the permissions of the file being replaced.
+        struct stat info;
+        mode_t mode = ::stat(path.c_str(), &info) == 0 ? (info.st_mode & 07777) : 0644;
+
+        bool ok = done == content.size() && fchmod(fd, mode) == 0 && fsync(fd) == 0;
+        ok      = ::close(fd) == 0 && ok;
+        if (!ok || std::rename(tmpPath.data(), path.c_str()) != 0) {
+            std::string reason = std::strerror(errno);
+            ::unlink(tmpPath.data());
+            throw cpp_config::ConfigurationError("Cannot write `" + path + "`: " + reason);
+        }
+
+        // Persist the rename itself.
+        size_t slash          = path.find_last_of('/');
+        std::string directory = slash == std::string::npos ? "." : path.substr(0, slash == 0 ? 1 : slash);
+        int dirFd             = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dirFd >= 0) {
+            fsync(dirFd);
+            ::close(dirFd);
+        }
+    }
+
+}  // namespace cpp_config
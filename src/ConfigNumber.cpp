@@ -0,0 +1,291 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#include "ConfigNumber.h"
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "ConfigExceptions.h"
+
+namespace cpp_config {
+    namespace {
+        struct Unit {
+                std::string_view suffix;
+                std::uint64_t scale;
+        };
+
+        // Largest first, so format() picks the largest unit that is exact.
+        constexpr std::array<Unit, 9> SizeUnits{{
+            {"TiB", 1ull << 40},
+            {"GiB", 1ull << 30},
+            {"MiB", 1ull << 20},
+            {"KiB", 1ull << 10},
+            {"TB", 1000ull * 1000 * 1000 * 1000},
+            {"GB", 1000ull * 1000 * 1000},
+            {"MB", 1000ull * 1000},
+            {"KB", 1000ull},
+            {"B", 1},
+        }};
+
+        constexpr std::array<Unit, 6> DurationUnits{{
+            {"h", 3600ull * 1000 * 1000 * 1000},
+            {"min", 60ull * 1000 * 1000 * 1000},
+            {"s", 1000ull * 1000 * 1000},
+            {"ms", 1000ull * 1000},
+            {"us", 1000ull},
+            {"ns", 1},
+        }};
+
+        template <std::size_t N>
+        const Unit *findUnit(const std::array<Unit, N> &units, std::string_view suffix) {
+            for (const auto &unit : units) {
+                if (unit.suffix == suffix) {
+                    return &unit;
+                }
+            }
+            return nullptr;
+        }
+
+        // Splits `text` into the number parsed by std::from_chars and the rest.
+        template <typename T>
+        bool parseNumber(std::string_view text, T &out, std::string_view &rest) {
+            auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+            if (ec != std::errc()) {
+                return false;
+            }
+            rest = text.substr(static_cast<std::size_t>(ptr - text.data()));
+            return true;
+        }
+
+        template <std::size_t N>
+        std::string formatScaled(const std::array<Unit, N> &units, std::int64_t value) {
+            std::uint64_t magnitude = value < 0 ? 0 - static_cast<std::uint64_t>(value) : static_cast<std::uint64_t>(value);
+            for (const auto &unit : units) {
+                if (magnitude % unit.scale == 0) {
+                    std::string text = value < 0 ? "-" : "";
+                    return text + std::to_string(magnitude / unit.scale) + std::string(unit.suffix);
+                }
+            }
+            return std::to_string(value);
+        }
+
+        // (value - min) % step for value >= min, without signed overflow.
+        bool onIntegerStep(std::int64_t value, std::int64_t min, std::int64_t step) {
+            return step == 0 || (static_cast<std::uint64_t>(value) - static_cast<std::uint64_t>(min)) % static_cast<std::uint64_t>(step) == 0;
+        }
+    }  // namespace
+
+    bool IntegerKind::parse(std::string_view text, Native &out) {
+        return parseStrict(text, out);
+    }
+    std::string IntegerKind::format(Native value) {
+        return std::to_string(value);
+    }
+    ConfigValue IntegerKind::store(const std::string &raw, Native value) {
+        return ConfigValue(raw, value);
+    }
+    bool IntegerKind::onStep(Native value, Native min, Native step) {
+        return onIntegerStep(value, min, step);
+    }
+
+    bool FloatKind::parse(std::string_view text, Native &out) {
+        Native value{};
+        if (!parseStrict(text, value) || !std::isfinite(value)) {
+            return false;
+        }
+        out = value;
+        return true;
+    }
+    std::string FloatKind::format(Native value) {
+        std::array<char, 32> buffer{};
+        auto [ptr, ec] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+        return std::string(buffer.data(), ptr);
+    }
+    ConfigValue FloatKind::store(const std::string &raw, Native value) {
+        return ConfigValue(raw, value);
+    }
+    // Steps are compared with a relative tolerance, so `0.1` steps from `0`
+    // accept `0.3` despite rounding.
+    bool FloatKind::onStep(Native value, Native min, Native step) {
+        if (step == 0) {
+            return true;
+        }
+        double steps = (value - min) / step;
+        return std::fabs(steps - std::nearbyint(steps)) <= 1e-9 * std::fmax(1.0, std::fabs(steps));
+    }
+
+    bool SizeKind::parse(std::string_view text, Native &out) {
+        Native value{};
+        std::string_view suffix;
+        if (!parseNumber(text, value, suffix)) {
+            return false;
+        }
+        std::uint64_t scale = 1;
+        if (!suffix.empty()) {
+            const Unit *unit = findUnit(SizeUnits, suffix);
+            if (unit == nullptr) {
+                return false;
+            }
+            scale = unit->scale;
+        }
+        if (value > highest() / scale) {
+            return false;
+        }
+        out = value * scale;
+        return true;
+    }
+    std::string SizeKind::format(Native value) {
+        return formatScaled(SizeUnits, static_cast<std::int64_t>(value));
+    }
+    ConfigValue SizeKind::store(const std::string &raw, Native value) {
+        return ConfigValue(raw, static_cast<std::int64_t>(value));
+    }
+    bool SizeKind::onStep(Native value, Native min, Native step) {
+        return step == 0 || (value - min) % step == 0;
+    }
+
+    bool DurationKind::parse(std::string_view text, Native &out) {
+        Native::rep value{};
+        std::string_view suffix;
+        if (!parseNumber(text, value, suffix)) {
+            return false;
+        }
+        const Unit *unit = findUnit(DurationUnits, suffix);
+        if (unit == nullptr) {
+            return false;
+        }
+        auto scale = static_cast<Native::rep>(unit->scale);
+        if (value > highest().count() / scale || value < lowest().count() / scale) {
+            return false;
+        }
+        out = Native(value * scale);
+        return true;
+    }
+    std::string DurationKind::format(Native value) {
+        return formatScaled(DurationUnits, value.count());
+    }
+    ConfigValue DurationKind::store(const std::string &raw, Native value) {
+        return ConfigValue(raw, value);
+    }
+    bool DurationKind::onStep(Native value, Native min, Native step) {
+        return onIntegerStep(value.count(), min.count(), step.count());
+    }
+
+    template <class Kind>
+    ConfigNumber<Kind>::ConfigNumber(const std::string &name, const std::string &description, const std::string &value, Native min, Native max, Native step)
+        : ConfigParameter(name, describe(description, min, max, step), parse(name, value, min, max, step, "Default value"), Kind::type),
+          _min(min),
+          _max(max),
+          _step(step) {
+    }
+    template <class Kind>
+    ConfigNumber<Kind>::~ConfigNumber() {
+    }
+    template <class Kind>
+    ConfigNumber<Kind>::ConfigNumber(const ConfigNumber &rhs) : ConfigParameter(rhs), _min(rhs._min), _max(rhs._max), _step(rhs._step) {
+    }
+    template <class Kind>
+    ConfigNumber<Kind>::ConfigNumber(ConfigNumber &&rhs) noexcept : ConfigParameter(std::move(rhs)), _min(rhs._min), _max(rhs._max), _step(rhs._step) {
+    }
+    template <class Kind>
+    ConfigNumber<Kind> &ConfigNumber<Kind>::operator=(const ConfigNumber &rhs) {
+        if (this != &rhs) {
+            ConfigParameter::operator=(rhs);
+            _min  = rhs._min;
+            _max  = rhs._max;
+            _step = rhs._step;
+        }
+        return *this;
+    }
+    template <class Kind>
+    ConfigNumber<Kind> &ConfigNumber<Kind>::operator=(ConfigNumber &&rhs) noexcept {
+        if (this != &rhs) {
+            ConfigParameter::operator=(std::move(rhs));
+            _min  = rhs._min;
+            _max  = rhs._max;
+            _step = rhs._step;
+        }
+        return *this;
+    }
+    template <class Kind>
+    std::shared_ptr<ConfigParameter> ConfigNumber<Kind>::clone() const {
+        return std::make_shared<ConfigNumber>(*this);
+    }
+    template <class Kind>
+    ConfigParameter *ConfigNumber<Kind>::cloneInto(std::pmr::memory_resource &memory) const {
+        return std::pmr::polymorphic_allocator<>(&memory).new_object<ConfigNumber>(*this);
+    }
+    template <class Kind>
+    void ConfigNumber<Kind>::set(const std::string &val) {
+        assign(parse(name(), val, _min, _max, _step, "Value"));
+    }
+
+    template <class Kind>
+    typename ConfigNumber<Kind>::Native ConfigNumber<Kind>::number() const {
+        return as<Native>();
+    }
+    template <class Kind>
+    typename ConfigNumber<Kind>::Native ConfigNumber<Kind>::min() const {
+        return _min;
+    }
+    template <class Kind>
+    typename ConfigNumber<Kind>::Native ConfigNumber<Kind>::max() const {
+        return _max;
+    }
+    template <class Kind>
+    typename ConfigNumber<Kind>::Native ConfigNumber<Kind>::step() const {
+        return _step;
+    }
+
+    // `description; [min, max], step s`, leaving out bounds that are not set.
+    template <class Kind>
+    std::string ConfigNumber<Kind>::describe(const std::string &description, Native min, Native max, Native step) {
+        std::string bounds;
+        if (min != Kind::lowest() && max != Kind::highest()) {
+            bounds = "[" + Kind::format(min) + ", " + Kind::format(max) + "]";
+        } else if (min != Kind::lowest()) {
+            bounds = ">= " + Kind::format(min);
+        } else if (max != Kind::highest()) {
+            bounds = "<= " + Kind::format(max);
+        }
+        if (step != Native{}) {
+            bounds += (bounds.empty() ? "step " : ", step ") + Kind::format(step);
+        }
+        return bounds.empty() ? description : description + "; " + bounds;
+    }
+
+    template <class Kind>
+    ConfigValue ConfigNumber<Kind>::parse(const std::string &name, const std::string &val, Native min, Native max, Native step, const char *what) {
+        if (max < min || step < Native{}) {
+            throw std::invalid_argument("Invalid bounds of `" + name + "`");
+        }
+        Native value{};
+        if (!Kind::parse(val, value)) {
+            throw cpp_config::ConfigurationError(std::string(what) + " `" + val + "` of `" + name + "` is not a valid " + Kind::name);
+        }
+        if (value < min || max < value) {
+            throw cpp_config::ConfigurationError(std::string(what) + " `" + val + "` of `" + name + "` is out of range " + describe("", min, max, Native{}).substr(2));
+        }
+        if (!Kind::onStep(value, min, step)) {
+            throw cpp_config::ConfigurationError(std::string(what) + " `" + val + "` of `" + name + "` is not on step " + Kind::format(step) + " from " + Kind::format(min));
+        }
+        return Kind::store(val, value);
+    }
+
+    template class ConfigNumber<IntegerKind>;
+    template class ConfigNumber<FloatKind>;
+    template class ConfigNumber<SizeKind>;
+    template class ConfigNumber<DurationKind>;
+}  // namespace cpp_config
@@ -11,23 +11,44 @@
 
 #include "ConfigParameter.h"
 
+#include "ConfigExceptions.h"
+
 namespace cpp_config {
 
-    ConfigParameter::ConfigParameter() : _name("name"), _description(""), _value("") {
+    ConfigParameter::ConfigParameter() : _name("name"), _description(""), _value(), _type(ConfigValue::Type::String) {
+    }
+
+    ConfigParameter::ConfigParameter(const std::string &name, const std::string &description, const std::string &value)
+        : ConfigParameter(name, description, value, ConfigValue::Type::String) {
+    }
+
+    ConfigParameter::ConfigParameter(const std::string &name, const std::string &description, const std::string &value, ConfigValue::Type type)
+        : _name(name), _description(description), _value(value), _type(type) {
+        if (_name.find(' ') != std::string::npos) {
+            throw std::invalid_argument("ConfigParameter name cannot contain spaces");
+        }
+        if (!_value.holds(_type)) {
+            std::stringstream ss;
+            ss << "Default value `" << value << "` of `" << _name << "` is not a valid " << toString(_type);
+
+            throw cpp_config::ConfigurationError(ss.str());
+        }
     }
 
-    ConfigParameter::ConfigParameter(const std::string &name, const std::string &description, const std::string &value) : _name(name), _description(description), _value(value) {
+    ConfigParameter::ConfigParameter(const std::string &name, const std::string &description, ConfigValue value, ConfigValue::Type type)
+        : _name(name), _description(description), _value(std::move(value)), _type(type) {
         if (_name.find(' ') != std::string::npos) {
             throw std::invalid_argument("ConfigParameter name cannot contain spaces");
         }
     }
+
     ConfigParameter::~ConfigParameter() {
     }
 
-    ConfigParameter::ConfigParameter(const ConfigParameter &rhs) : _name(rhs._name), _description(rhs._description), _value(rhs._value) {
+    ConfigParameter::ConfigParameter(const ConfigParameter &rhs) : _name(rhs._name), _description(rhs._description), _value(rhs._value), _type(rhs._type) {
     }
 
-    ConfigParameter::ConfigParameter(const ConfigParameter &&rhs) : _name(std::move(rhs._name)), _description(std::move(rhs._description)), _value(std::move(rhs._value)) {
+    ConfigParameter::ConfigParameter(ConfigParameter &&rhs) noexcept : _name(std::move(rhs._name)), _description(std::move(rhs._description)), _value(std::move(rhs._value)), _type(rhs._type) {
     }
 
     ConfigParameter &ConfigParameter::operator=(const ConfigParameter &rhs) {
@@ -35,31 +56,62 @@ namespace cpp_config {
             _name        = rhs._name;
             _description = rhs._description;
             _value       = rhs._value;
+            _type        = rhs._type;
         }
         return *this;
     }
 
-    ConfigParameter &ConfigParameter::operator=(const ConfigParameter &&rhs) {
+    ConfigParameter &ConfigParameter::operator=(ConfigParameter &&rhs) noexcept {
         if (this != &rhs) {
             _name        = std::move(rhs._name);
             _description = std::move(rhs._description);
             _value       = std::move(rhs._value);
+            _type        = rhs._type;
         }
         return *this;
     }
 
-    const std::string ConfigParameter::name() const {
+    const std::string &ConfigParameter::name() const {
         return _name;
     }
-    const std::string ConfigParameter::description() const {
+    const std::string &ConfigParameter::description() const {
         return _description;
     }
-    const std::string ConfigParameter::value() const {
+    const std::string &ConfigParameter::value() const {
+        return _value.raw();
+    }
+    const ConfigValue &ConfigParameter::parsed() const {
         return _value;
     }
+    ConfigValue::Type ConfigParameter::type() const {
+        return _type;
+    }
+
+    std::shared_ptr<ConfigParameter> ConfigParameter::clone() const {
+        return std::make_shared<ConfigParameter>(*this);
+    }
+
+    ConfigParameter *ConfigParameter::cloneInto(std::pmr::memory_resource &memory) const {
+        return std::pmr::polymorphic_allocator<>(&memory).new_object<ConfigParameter>(*this);
+    }
 
     void ConfigParameter::set(const std::string &val) {
-        _value = val;
+        ConfigValue parsed(val);
+        if (!parsed.holds(_type)) {
+            std::stringstream ss;
+            ss << "Value `" << val << "` of `" << _name << "` is not a valid " << toString(_type);
+
+            throw cpp_config::ConfigurationError(ss.str());
+        }
+        _value = std::move(parsed);
+    }
+
+    void ConfigParameter::restore(ConfigValue value) {
+        _value = std::move(value);
+    }
+
+    void ConfigParameter::assign(ConfigValue value) {
+        _value = std::move(value);
     }
 
 }  // namespace cpp_config
@@ -0,0 +1,275 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#include "ConfigParser.h"
+
+namespace cpp_config {
+
+    namespace {
+
+        bool isSpace(char c) {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+        }
+
+        std::string_view trim(std::string_view text) {
+            while (!text.empty() && isSpace(text.front())) {
+                text.remove_prefix(1);
+            }
+            while (!text.empty() && isSpace(text.back())) {
+                text.remove_suffix(1);
+            }
+            return text;
+        }
+
+        // What may follow a section header or a quoted value.
+        bool isTrailer(std::string_view text) {
+            text = trim(text);
+            return text.empty() || text[0] == '#' || text[0] == ';';
+        }
+
+        // Position of the `=` separating key and value, skipping quoted key parts.
+        std::size_t findDelimiter(std::string_view line) {
+            for (std::size_t i = 0; i < line.size(); ++i) {
+                if (line[i] == '=') {
+                    return i;
+                }
+                if (line[i] == '"' || line[i] == '\'') {
+                    i = line.find(line[i], i + 1);
+                    if (i == std::string_view::npos) {
+                        return i;
+                    }
+                }
+            }
+            return std::string_view::npos;
+        }
+
+        // A key that needs no unquoting or trimming of its parts.
+        bool isPlain(std::string_view key) {
+            for (char c : key) {
+                if (c == '"' || c == '\'' || c == '.' || isSpace(c)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Position of the closing `"` or of the next escape in a basic string.
+        std::size_t findQuoteOrEscape(std::string_view text, std::size_t pos) {
+            for (; pos < text.size(); ++pos) {
+                if (text[pos] == '"' || text[pos] == '\\') {
+                    return pos;
+                }
+            }
+            return std::string_view::npos;
+        }
+
+    }  // namespace
+
+    IniTokenizer::Line IniTokenizer::parse(std::string_view line) {
+        _origin = line.data();
+        line    = trim(line);
+        if (line.empty() || line[0] == '#' || line[0] == ';') {
+            return Line::Blank;
+        }
+
+        if (line[0] == '[') {
+            std::size_t close = line.find(']');
+            _section.clear();
+            _sectionValid = false;
+            if (close == std::string_view::npos) {
+                return fail(line.data(), "unterminated section header");
+            }
+            if (!isTrailer(line.substr(close + 1))) {
+                return fail(trim(line.substr(close + 1)).data(), "unexpected text after section header");
+            }
+            if (!qualify(line.substr(1, close - 1), _section)) {
+                return fail(line.data() + 1, "invalid section name");
+            }
+            _sectionValid = true;
+            return Line::Section;
+        }
+
+        std::size_t delimiter = findDelimiter(line);
+        if (delimiter == std::string_view::npos) {
+            return fail(line.data(), "expected `key = value`");
+        }
+        if (!_sectionValid) {
+            return fail(line.data(), "entry under an invalid section header");
+        }
+        std::string_view key = trim(line.substr(0, delimiter));
+        if (key.empty()) {
+            return fail(line.data() + delimiter, "empty key");
+        }
+        if (_section.empty() && isPlain(key)) {
+            _name = key;
+        } else {
+            _nameBuffer.assign(_section);
+            if (!qualify(key, _nameBuffer)) {
+                return fail(key.data(), "invalid key");
+            }
+            _name = _nameBuffer;
+        }
+        _column              = static_cast<std::size_t>(key.data() - _origin) + 1;
+        std::string_view text = trim(line.substr(delimiter + 1));
+        _valueColumn          = static_cast<std::size_t>((text.empty() ? line.data() + line.size() : text.data()) - _origin) + 1;
+        return parseValue(text) ? Line::Entry : Line::Malformed;
+    }
+
+    IniTokenizer::Line IniTokenizer::fail(const char *at, const char *reason) {
+        _column = static_cast<std::size_t>(at - _origin) + 1;
+        _error  = reason;
+        return Line::Malformed;
+    }
+
+    // Appends the dot separated parts of `key` to `out`, trimmed and unquoted.
+    bool IniTokenizer::qualify(std::string_view key, std::string &out) {
+        std::size_t pos = 0;
+        while (true) {
+            while (pos < key.size() && isSpace(key[pos])) {
+                ++pos;
+            }
+            std::string_view part;
+            if (pos < key.size() && (key[pos] == '"' || key[pos] == '\'')) {
+                std::size_t close = key.find(key[pos], pos + 1);
+                if (close == std::string_view::npos) {
+                    return false;
+                }
+                part = key.substr(pos + 1, close - pos - 1);
+                pos  = close + 1;
+                while (pos < key.size() && isSpace(key[pos])) {
+                    ++pos;
+                }
+            } else {
+                std::size_t dot = key.find('.', pos);
+                if (dot == std::string_view::npos) {
+                    dot = key.size();
+                }
+                part = trim(key.substr(pos, dot - pos));
+                pos  = dot;
+                if (part.empty()) {
+                    return false;
+                }
+            }
+            if (!out.empty()) {
+                out.push_back('.');
+            }
+            out.append(part);
+            if (pos == key.size()) {
+                return true;
+            }
+            if (key[pos] != '.') {
+                return false;
+            }
+            ++pos;
+        }
+    }
+
+    bool IniTokenizer::parseValue(std::string_view text) {
+        if (text.empty() || (text[0] != '"' && text[0] != '\'')) {
+            for (std::size_t pos = 1; pos < text.size(); ++pos) {
+                if ((text[pos] == '#' || text[pos] == ';') && isSpace(text[pos - 1])) {
+                    text = trim(text.substr(0, pos));
+                    break;
+                }
+            }
+            _value = text;
+            return true;
+        }
+
+        std::size_t close;
+        if (text[0] == '\'') {
+            close = text.find('\'', 1);
+            if (close == std::string_view::npos) {
+                fail(text.data(), "unterminated string");
+                return false;
+            }
+            _value = text.substr(1, close - 1);
+        } else {
+            close = findQuoteOrEscape(text, 1);
+            if (close != std::string_view::npos && text[close] == '"') {
+                _value = text.substr(1, close - 1);
+            } else {
+                _valueBuffer.clear();
+                std::size_t pos = 1;
+                while (close != std::string_view::npos && text[close] == '\\') {
+                    _valueBuffer.append(text.substr(pos, close - pos));
+                    char escaped = close + 1 < text.size() ? text[close + 1] : '\0';
+                    switch (escaped) {
+                        case '\\':
+                        case '"':
+                            _valueBuffer.push_back(escaped);
+                            break;
+                        case 'n':
+                            _valueBuffer.push_back('\n');
+                            break;
+                        case 't':
+                            _valueBuffer.push_back('\t');
+                            break;
+                        case 'r':
+                            _valueBuffer.push_back('\r');
+                            break;
+                        default:
+                            fail(text.data() + close, "invalid escape sequence");
+                            return false;
+                    }
+                    pos   = close + 2;
+                    close = findQuoteOrEscape(text, pos);
+                }
+                if (close == std::string_view::npos) {
+                    fail(text.data(), "unterminated string");
+                    return false;
+                }
+                _valueBuffer.append(text.substr(pos, close - pos));
+                _value = _valueBuffer;
+            }
+        }
+        if (!isTrailer(text.substr(close + 1))) {
+            fail(trim(text.substr(close + 1)).data(), "unexpected text after string");
+            return false;
+        }
+        return true;
+    }
+
+    void appendValue(std::string &out, std::string_view value) {
+        bool quote = !value.empty() && (isSpace(value.front()) || isSpace(value.back()) || value.front() == '"' || value.front() == '\'');
+        for (std::size_t i = 0; !quote && i < value.size(); ++i) {
+            quote = value[i] == '\n' || ((value[i] == '#' || value[i] == ';') && i > 0 && isSpace(value[i - 1]));
+        }
+        if (!quote) {
+            out.append(value);
+            return;
+        }
+        out.push_back('"');
+        for (char c : value) {
+            switch (c) {
+                case '\\':
+                    out.append("\\\\");
+                    break;
+                case '"':
+                    out.append("\\\"");
+                    break;
+                case '\n':
+                    out.append("\\n");
+                    break;
+                case '\t':
+                    out.append("\\t");
+                    break;
+                case '\r':
+                    out.append("\\r");
+                    break;
+                default:
+                    out.push_back(c);
+            }
+        }
+        out.push_back('"');
+    }
+
+}  // namespace cpp_config
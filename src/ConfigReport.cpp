@@ -0,0 +1,77 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#include "ConfigReport.h"
+
+#include <utility>
+
+namespace cpp_config {
+
+    const char *toString(LoadIssue::Reason reason) {
+        switch (reason) {
+            case LoadIssue::Reason::Malformed:
+                return "malformed line";
+            case LoadIssue::Reason::UnknownKey:
+                return "unknown key";
+            case LoadIssue::Reason::InvalidValue:
+                return "invalid value";
+            case LoadIssue::Reason::DuplicateKey:
+                return "duplicate key";
+        }
+        return "unknown";
+    }
+
+    void LoadReport::add(LoadIssue issue) {
+        if (issue.error()) {
+            ++_errors;
+        }
+        _issues.push_back(std::move(issue));
+    }
+
+    const std::vector<LoadIssue> &LoadReport::issues() const {
+        return _issues;
+    }
+
+    std::size_t LoadReport::errors() const {
+        return _errors;
+    }
+
+    bool LoadReport::ok() const {
+        return _errors == 0;
+    }
+
+    std::string LoadReport::toString() const {
+        std::string out;
+        for (const auto &issue : _issues) {
+            out.append(issue.source)
+                .append(":")
+                .append(std::to_string(issue.line))
+                .append(":")
+                .append(std::to_string(issue.column))
+                .append(": ")
+                .append(cpp_config::toString(issue.reason));
+            if (!issue.key.empty()) {
+                out.append(" `").append(issue.key).append("`");
+            }
+            out.append(": ").append(issue.message).append("\n");
+        }
+        return out;
+    }
+
+    ConfigLoadError::ConfigLoadError(LoadReport report)
+        : ConfigurationError(std::to_string(report.errors()) + " error(s) in configuration:\n" + report.toString()), _report(std::move(report)) {
+    }
+
+    const LoadReport &ConfigLoadError::report() const {
+        return _report;
+    }
+
+}  // namespace cpp_config
@@ -0,0 +1,358 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#include "ConfigShared.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "ConfigExceptions.h"
+
+namespace cpp_config {
+    namespace {
+        constexpr std::uint64_t Magic   = 0x0053474643505043ULL;  // "CPPCFGS"
+        constexpr std::uint64_t Version = 2;
+
+        // Word indexes; the sequence starts a cache line of its own.
+        constexpr std::size_t MagicWord      = 0;
+        constexpr std::size_t VersionWord    = 1;
+        constexpr std::size_t SchemaWord     = 2;
+        constexpr std::size_t SlotsWord      = 3;
+        constexpr std::size_t TextBytesWord  = 4;
+        constexpr std::size_t SequenceWord   = 8;
+        constexpr std::size_t GenerationWord = 9;
+        constexpr std::size_t FirstSlotWord  = 16;
+        constexpr std::size_t SlotWords      = 4;  // integer, floating, flags | length, offset | choice
+
+        constexpr std::size_t WordSize = sizeof(std::uint64_t);
+
+        std::size_t wordsFor(std::size_t bytes) {
+            return (bytes + WordSize - 1) / WordSize;
+        }
+
+        std::size_t textWord(std::size_t slots) {
+            return FirstSlotWord + slots * SlotWords;
+        }
+
+        std::size_t segmentSize(std::size_t slots, std::size_t textBytes) {
+            return (textWord(slots) + wordsFor(textBytes)) * WordSize;
+        }
+
+        // Spin hint for a reader waiting for the writer; no system call.
+        void relax() {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+        }
+
+        // Retries of a reader while the sequence is odd or changes. A
+        // publisher that dies in the middle of a write leaves the sequence
+        // odd for good, so the reader gives up once it waited longer than
+        // `timeout`; the clock is read only every CheckEvery spins.
+        class WriterWait {
+            public:
+                WriterWait(const std::string &name, std::chrono::nanoseconds timeout) : _name(name), _timeout(timeout), _spins(0) {
+                }
+
+                void operator()() {
+                    relax();
+                    if (++_spins % CheckEvery != 0) {
+                        return;
+                    }
+                    const auto now = std::chrono::steady_clock::now();
+                    if (_spins == CheckEvery) {
+                        _deadline = now + _timeout;
+                    } else if (now > _deadline) {
+                        throw cpp_config::ConfigurationError(
+                            "Shared memory segment `" + _name + "` is still being written after " +
+                            std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(_timeout).count()) + " ms; its publisher may have died");
+                    }
+                }
+
+            private:
+                static constexpr std::uint64_t CheckEvery = 1024;
+
+                const std::string &_name;
+                std::chrono::nanoseconds _timeout;
+                std::uint64_t _spins;
+                std::chrono::steady_clock::time_point _deadline;
+        };
+
+        ConfigValue::Parsed unpack(std::uint64_t integer, std::uint64_t floating, std::uint64_t meta, std::uint64_t place) {
+            return {std::bit_cast<std::int64_t>(integer), std::bit_cast<double>(floating), ((meta >> 8) & 1) != 0, static_cast<std::uint8_t>(meta & 0xff),
+                    static_cast<std::uint32_t>(place >> 32)};
+        }
+
+        std::uint64_t *map(int fd, std::size_t size, int protection) {
+            void *mapping = ::mmap(nullptr, size, protection, MAP_SHARED, fd, 0);
+            return mapping == MAP_FAILED ? nullptr : static_cast<std::uint64_t *>(mapping);
+        }
+    }  // namespace
+
+    SharedSegment::SharedSegment(std::string name, std::uint64_t *words, std::size_t size, std::size_t slots, std::size_t textBytes, bool owner)
+        : _name(std::move(name)), _words(words), _size(size), _slots(slots), _textBytes(textBytes), _owner(owner) {
+    }
+
+    // An existing segment is never taken over: it may belong to a live
+    // publisher, whose readers would then see a foreign table.
+    SharedSegment SharedSegment::create(const std::string &name, std::uint64_t schemaHash, std::size_t slots, std::size_t textBytes, ::mode_t mode) {
+        int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, mode);
+        if (fd < 0 && errno == EEXIST) {
+            throw cpp_config::ConfigurationError("Shared memory segment `" + name +
+                                                 "` already exists; another publisher may own it, or SharedSegment::remove() it if its publisher died");
+        }
+        if (fd < 0) {
+            throw cpp_config::ConfigurationError("Cannot create shared memory segment `" + name + "`: " + std::strerror(errno));
+        }
+        const std::size_t size = segmentSize(slots, textBytes);
+        std::uint64_t *words   = nullptr;
+        // the umask may have taken permissions from `mode`
+        if (::fchmod(fd, mode) == 0 && ::ftruncate(fd, static_cast<off_t>(size)) == 0) {
+            words = map(fd, size, PROT_READ | PROT_WRITE);
+        }
+        std::string reason = std::strerror(errno);
+        ::close(fd);
+        if (words == nullptr) {
+            ::shm_unlink(name.c_str());
+            throw cpp_config::ConfigurationError("Cannot map shared memory segment `" + name + "`: " + reason);
+        }
+
+        SharedSegment segment(name, words, size, slots, textBytes, true);
+        segment.store(VersionWord, Version);
+        segment.store(SchemaWord, schemaHash);
+        segment.store(SlotsWord, slots);
+        segment.store(TextBytesWord, textBytes);
+        return segment;
+    }
+
+    SharedSegment SharedSegment::open(const std::string &name, std::uint64_t schemaHash, std::size_t slots, std::chrono::nanoseconds writeTimeout) {
+        int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            throw cpp_config::ConfigurationError("Cannot open shared memory segment `" + name + "`: " + std::strerror(errno));
+        }
+        struct stat info;
+        std::uint64_t *words = nullptr;
+        std::size_t size     = 0;
+        if (::fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) >= FirstSlotWord * WordSize) {
+            size  = static_cast<std::size_t>(info.st_size);
+            words = map(fd, size, PROT_READ);
+        }
+        ::close(fd);
+        if (words == nullptr) {
+            throw cpp_config::ConfigurationError("Cannot map shared memory segment `" + name + "`");
+        }
+
+        SharedSegment segment(name, words, size, slots, 0, false);
+        // the magic is written last, once the first table is complete
+        if (segment.load(MagicWord, std::memory_order_acquire) != Magic || segment.load(VersionWord) != Version) {
+            throw cpp_config::ConfigurationError("`" + name + "` is not a published configuration");
+        }
+        if (segment.load(SchemaWord) != schemaHash || segment.load(SlotsWord) != slots) {
+            throw cpp_config::ConfigurationError("`" + name + "` was published for different parameters");
+        }
+        segment._textBytes    = segment.load(TextBytesWord);
+        segment._writeTimeout = writeTimeout;
+        if (segmentSize(slots, segment._textBytes) > size) {
+            throw cpp_config::ConfigurationError("`" + name + "` is truncated");
+        }
+        return segment;
+    }
+
+    SharedSegment::~SharedSegment() {
+        release();
+    }
+
+    SharedSegment::SharedSegment(SharedSegment &&rhs) noexcept
+        : _name(std::move(rhs._name)), _words(rhs._words), _size(rhs._size), _slots(rhs._slots), _textBytes(rhs._textBytes),
+          _owner(rhs._owner),
+          _writeTimeout(rhs._writeTimeout) {
+        rhs._words = nullptr;
+        rhs._owner = false;
+    }
+
+    SharedSegment &SharedSegment::operator=(SharedSegment &&rhs) noexcept {
+        if (this != &rhs) {
+            release();
+            _name         = std::move(rhs._name);
+            _words        = std::exchange(rhs._words, nullptr);
+            _size         = rhs._size;
+            _slots        = rhs._slots;
+            _textBytes    = rhs._textBytes;
+            _owner        = std::exchange(rhs._owner, false);
+            _writeTimeout = rhs._writeTimeout;
+        }
+        return *this;
+    }
+
+    void SharedSegment::release() noexcept {
+        if (_words != nullptr) {
+            ::munmap(_words, _size);
+            _words = nullptr;
+        }
+        if (_owner) {
+            ::shm_unlink(_name.c_str());
+            _owner = false;
+        }
+    }
+
+    void SharedSegment::write(std::uint64_t generation, const std::vector<const ConfigValue *> &values) {
+        if (values.size() != _slots) {
+            throw std::invalid_argument("Shared memory segment `" + _name + "` holds " + std::to_string(_slots) + " values");
+        }
+        std::size_t needed = 0;
+        for (const ConfigValue *value : values) {
+            needed += wordsFor(value->raw().size()) * WordSize;
+        }
+        if (needed > _textBytes) {
+            throw cpp_config::ConfigurationError("Values need " + std::to_string(needed) + " bytes, shared memory segment `" + _name + "` holds " +
+                                                 std::to_string(_textBytes));
+        }
+
+        // Every data word is stored with release, so it cannot become
+        // visible before the odd sequence: a reader that loads it (with
+        // acquire) also sees that sequence when it checks it again.
+        const std::uint64_t sequence = load(SequenceWord) + 1;
+        store(SequenceWord, sequence);
+
+        std::size_t offset = 0;  // in words, within the text
+        for (std::size_t slot = 0; slot < _slots; ++slot) {
+            const ConfigValue::Parsed parsed = values[slot]->parsed();
+            const std::string &raw           = values[slot]->raw();
+            const std::size_t base           = FirstSlotWord + slot * SlotWords;
+            store(base, std::bit_cast<std::uint64_t>(parsed.integer), std::memory_order_release);
+            store(base + 1, std::bit_cast<std::uint64_t>(parsed.floating), std::memory_order_release);
+            store(base + 2, parsed.flags | (static_cast<std::uint64_t>(parsed.boolean) << 8) | (static_cast<std::uint64_t>(raw.size()) << 32),
+                  std::memory_order_release);
+            store(base + 3, offset | (static_cast<std::uint64_t>(parsed.choice) << 32), std::memory_order_release);
+            for (std::size_t pos = 0; pos < raw.size(); pos += WordSize) {
+                std::uint64_t word = 0;
+                std::memcpy(&word, raw.data() + pos, std::min(WordSize, raw.size() - pos));
+                store(textWord(_slots) + offset++, word, std::memory_order_release);
+            }
+        }
+        store(GenerationWord, generation, std::memory_order_release);
+
+        store(SequenceWord, sequence + 1, std::memory_order_release);
+        if (load(MagicWord) != Magic) {
+            store(MagicWord, Magic, std::memory_order_release);
+        }
+    }
+
+    ConfigValue SharedSegment::read(std::size_t slot) const {
+        if (slot >= _slots) {
+            throw std::out_of_range("Parameter is not registered");
+        }
+        const std::size_t base = FirstSlotWord + slot * SlotWords;
+        const std::size_t text = textWord(_slots);
+        std::string raw;
+        WriterWait wait(_name, _writeTimeout);
+        while (true) {
+            const std::uint64_t sequence = load(SequenceWord, std::memory_order_acquire);
+            if (sequence & 1) {
+                wait();
+                continue;
+            }
+            // acquire keeps the second load of the sequence after the data
+            const std::uint64_t integer  = load(base, std::memory_order_acquire);
+            const std::uint64_t floating = load(base + 1, std::memory_order_acquire);
+            const std::uint64_t meta     = load(base + 2, std::memory_order_acquire);
+            const std::uint64_t place    = load(base + 3, std::memory_order_acquire);
+            const std::uint64_t offset   = place & 0xffffffff;
+            const std::size_t length     = static_cast<std::size_t>(meta >> 32);
+            // a torn slot may point anywhere; it is never used
+            const bool inside = (offset + wordsFor(length)) * WordSize <= _textBytes;
+            if (inside) {
+                raw.resize(length);
+                for (std::size_t pos = 0; pos < length; pos += WordSize) {
+                    std::uint64_t word = load(text + offset + pos / WordSize, std::memory_order_acquire);
+                    std::memcpy(raw.data() + pos, &word, std::min(WordSize, length - pos));
+                }
+            }
+            if (inside && load(SequenceWord) == sequence) {
+                return ConfigValue(raw, unpack(integer, floating, meta, place));
+            }
+            wait();
+        }
+    }
+
+    ConfigValue::Parsed SharedSegment::parsed(std::size_t slot) const {
+        if (slot >= _slots) {
+            throw std::out_of_range("Parameter is not registered");
+        }
+        const std::size_t base = FirstSlotWord + slot * SlotWords;
+        WriterWait wait(_name, _writeTimeout);
+        while (true) {
+            const std::uint64_t sequence = load(SequenceWord, std::memory_order_acquire);
+            if (sequence & 1) {
+                wait();
+                continue;
+            }
+            const std::uint64_t integer  = load(base, std::memory_order_acquire);
+            const std::uint64_t floating = load(base + 1, std::memory_order_acquire);
+            const std::uint64_t meta     = load(base + 2, std::memory_order_acquire);
+            const std::uint64_t place    = load(base + 3, std::memory_order_acquire);
+            if (load(SequenceWord) == sequence) {
+                return unpack(integer, floating, meta, place);
+            }
+            wait();
+        }
+    }
+
+    std::uint64_t SharedSegment::generation() const {
+        WriterWait wait(_name, _writeTimeout);
+        while (true) {
+            const std::uint64_t sequence = load(SequenceWord, std::memory_order_acquire);
+            const std::uint64_t result   = load(GenerationWord, std::memory_order_acquire);
+            if (!(sequence & 1) && load(SequenceWord) == sequence) {
+                return result;
+            }
+            wait();
+        }
+    }
+
+    const std::string &SharedSegment::name() const {
+        return _name;
+    }
+
+    std::size_t SharedSegment::slots() const {
+        return _slots;
+    }
+
+    void SharedSegment::unlink() {
+        ::shm_unlink(_name.c_str());
+        _owner = false;
+    }
+
+    void SharedSegment::remove(const std::string &name) {
+        ::shm_unlink(name.c_str());
+    }
+
+    // Shared words are only accessed atomically; readers map the segment
+    // read-only, where an atomic load of a word is a plain load.
+    std::uint64_t SharedSegment::load(std::size_t word, std::memory_order order) const {
+        return std::atomic_ref<std::uint64_t>(_words[word]).load(order);
+    }
+
+    void SharedSegment::store(std::size_t word, std::uint64_t value, std::memory_order order) {
+        std::atomic_ref<std::uint64_t>(_words[word]).store(value, order);
+    }
+}  // namespace cpp_config
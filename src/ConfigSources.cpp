@@ -0,0 +1,100 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#include "ConfigSources.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace cpp_config {
+
+    const std::shared_ptr<const ValueSource> &ValueSource::defaults() {
+        static const std::shared_ptr<const ValueSource> source = std::make_shared<const ValueSource>(ValueSource{Kind::Default, ""});
+        return source;
+    }
+
+    const std::shared_ptr<const ValueSource> &ValueSource::runtime() {
+        static const std::shared_ptr<const ValueSource> source = std::make_shared<const ValueSource>(ValueSource{Kind::Runtime, ""});
+        return source;
+    }
+
+    const char *toString(ValueSource::Kind kind) {
+        switch (kind) {
+            case ValueSource::Kind::Default:
+                return "default";
+            case ValueSource::Kind::File:
+                return "file";
+            case ValueSource::Kind::Environment:
+                return "environment";
+            case ValueSource::Kind::CommandLine:
+                return "command line";
+            case ValueSource::Kind::Runtime:
+                return "runtime";
+        }
+        return "unknown";
+    }
+
+    ConfigSources &ConfigSources::file(std::string path, bool optional) {
+        _layers.push_back({ValueSource::Kind::File, std::move(path), optional, {}});
+        return *this;
+    }
+
+    ConfigSources &ConfigSources::environment(std::string prefix) {
+        _layers.push_back({ValueSource::Kind::Environment, std::move(prefix), true, {}});
+        return *this;
+    }
+
+    ConfigSources &ConfigSources::commandLine(int argc, const char *const argv[]) {
+        Layer layer{ValueSource::Kind::CommandLine, "command line", true, {}};
+        layer.arguments.assign(argv + std::min(argc, 1), argv + argc);
+        _layers.push_back(std::move(layer));
+        return *this;
+    }
+
+    std::vector<std::pair<std::string, std::string>> ConfigSources::options(const Layer &layer,
+                                                                           const std::function<bool(std::string_view)> &takesValue) {
+        std::vector<std::pair<std::string, std::string>> result;
+        const std::vector<std::string> &args = layer.arguments;
+        for (std::size_t i = 0; i < args.size(); ++i) {
+            std::string_view arg(args[i]);
+            if (arg == "--") {
+                break;
+            }
+            if (arg.size() <= 2 || arg.substr(0, 2) != "--") {
+                continue;
+            }
+            arg.remove_prefix(2);
+            std::size_t eq = arg.find('=');
+            if (eq != std::string_view::npos) {
+                result.emplace_back(arg.substr(0, eq), arg.substr(eq + 1));
+            } else if (i + 1 < args.size() && std::string_view(args[i + 1]).substr(0, 2) != "--" && takesValue(arg)) {
+                result.emplace_back(arg, args[++i]);
+            } else {
+                result.emplace_back(arg, "true");
+            }
+        }
+        return result;
+    }
+
+    const std::vector<ConfigSources::Layer> &ConfigSources::layers() const {
+        return _layers;
+    }
+
+    std::string ConfigSources::environmentName(std::string_view prefix, std::string_view name) {
+        std::string result(prefix);
+        result.reserve(prefix.size() + name.size());
+        for (unsigned char c : name) {
+            result.push_back(std::isalnum(c) ? static_cast<char>(std::toupper(c)) : '_');
+        }
+        return result;
+    }
+
+}  // namespace cpp_config
@@ -0,0 +1,79 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#include "ConfigStats.h"
+
+#include <cstdio>
+
+namespace cpp_config {
+
+    namespace {
+
+        std::string formatDuration(std::chrono::nanoseconds duration) {
+            char buffer[32];
+            auto nanos = duration.count();
+            if (nanos < 1000) {
+                std::snprintf(buffer, sizeof(buffer), "%lldns", static_cast<long long>(nanos));
+            } else if (nanos < 1000 * 1000) {
+                std::snprintf(buffer, sizeof(buffer), "%.1fus", static_cast<double>(nanos) / 1e3);
+            } else if (nanos < 1000 * 1000 * 1000) {
+                std::snprintf(buffer, sizeof(buffer), "%.1fms", static_cast<double>(nanos) / 1e6);
+            } else {
+                std::snprintf(buffer, sizeof(buffer), "%.2fs", static_cast<double>(nanos) / 1e9);
+            }
+            return buffer;
+        }
+
+    }  // namespace
+
+    const std::array<std::chrono::microseconds, ConfigStatistics::ReloadBuckets - 1> &ConfigStatistics::reloadBounds() {
+        using std::chrono::microseconds;
+        static const std::array<microseconds, ReloadBuckets - 1> bounds{
+            microseconds(10),    microseconds(50),    microseconds(100),    microseconds(500),    microseconds(1000),    microseconds(5000),
+            microseconds(10000), microseconds(50000), microseconds(100000), microseconds(500000), microseconds(1000000),
+        };
+        return bounds;
+    }
+
+    std::size_t ConfigStatistics::bucketOf(std::chrono::nanoseconds duration) {
+        const auto &bounds = reloadBounds();
+        std::size_t bucket = 0;
+        while (bucket < bounds.size() && duration > bounds[bucket]) {
+            ++bucket;
+        }
+        return bucket;
+    }
+
+    std::string ConfigStatistics::toString() const {
+        std::string out;
+        out.append("reloads: ").append(std::to_string(reloads));
+        out.append(" (failed: ").append(std::to_string(failedReloads)).append(")");
+        out.append(", total: ").append(formatDuration(reloadTotal));
+        out.append(", max: ").append(formatDuration(reloadMax)).append("\n");
+        out.append("malformed lines: ").append(std::to_string(malformedLines)).append("\n");
+        out.append("unknown keys: ").append(std::to_string(unknownKeys)).append("\n");
+        out.append("rejected values: ").append(std::to_string(rejectedValues)).append("\n");
+
+        out.append("reload duration:\n");
+        const auto &bounds = reloadBounds();
+        for (std::size_t i = 0; i < ReloadBuckets; ++i) {
+            out.append(i < bounds.size() ? "  <= " + formatDuration(bounds[i]) : "  >  " + formatDuration(bounds.back()));
+            out.append(": ").append(std::to_string(reloadHistogram[i])).append("\n");
+        }
+
+        out.append("reads:\n");
+        for (const auto &param : reads) {
+            out.append("  ").append(param.name).append(": ").append(std::to_string(param.count)).append("\n");
+        }
+        return out;
+    }
+
+}  // namespace cpp_config
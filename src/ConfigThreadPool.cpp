@@ -0,0 +1,165 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#include "ConfigThreadPool.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace cpp_config {
+
+    WorkStealingPool::WorkStealingPool(std::size_t threads) {
+        if (threads == 0) {
+            threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        }
+        for (std::size_t i = 0; i < threads; ++i) {
+            _queues.push_back(std::make_unique<Queue>());
+        }
+        for (std::size_t i = 0; i < threads; ++i) {
+            _threads.emplace_back([this, i]() { work(i); });
+        }
+    }
+
+    WorkStealingPool::~WorkStealingPool() {
+        _stop.store(true, std::memory_order_release);
+        _generation.fetch_add(1, std::memory_order_release);
+        _generation.notify_all();
+        for (auto &thread : _threads) {
+            thread.join();
+        }
+    }
+
+    std::size_t WorkStealingPool::size() const {
+        return _threads.size();
+    }
+
+    void WorkStealingPool::parallelFor(std::size_t count, const std::function<void(std::size_t)> &task) {
+        if (count == 0) {
+            return;
+        }
+        std::lock_guard<std::mutex> batch(_batchMutex);
+        _task.store(&task, std::memory_order_release);
+        _remaining.store(count, std::memory_order_release);
+
+        const std::size_t workers = _queues.size();
+        for (std::size_t w = 0; w < workers; ++w) {
+            std::lock_guard<std::mutex> queueLock(_queues[w]->mutex);
+            for (std::size_t i = count * w / workers; i < count * (w + 1) / workers; ++i) {
+                _queues[w]->items.push_back(i);
+            }
+        }
+        _generation.fetch_add(1, std::memory_order_release);
+        _generation.notify_all();
+
+        for (std::size_t left = _remaining.load(std::memory_order_acquire); left != 0; left = _remaining.load(std::memory_order_acquire)) {
+            _remaining.wait(left, std::memory_order_acquire);
+        }
+        _task.store(nullptr, std::memory_order_release);
+
+        std::lock_guard<std::mutex> lock(_errorMutex);
+        if (_error) {
+            std::rethrow_exception(std::exchange(_error, nullptr));
+        }
+    }
+
+    bool WorkStealingPool::next(std::size_t self, std::size_t &index) {
+        {
+            Queue &own = *_queues[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.items.empty()) {
+                index = own.items.back();
+                own.items.pop_back();
+                return true;
+            }
+        }
+        for (std::size_t offset = 1; offset < _queues.size(); ++offset) {
+            Queue &victim = *_queues[(self + offset) % _queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.items.empty()) {
+                index = victim.items.front();
+                victim.items.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void WorkStealingPool::work(std::size_t self) {
+        std::uint64_t seen = 0;
+        while (true) {
+            _generation.wait(seen, std::memory_order_acquire);
+            if (_stop.load(std::memory_order_acquire)) {
+                return;
+            }
+            seen = _generation.load(std::memory_order_acquire);
+
+            // A worker still draining may already pick up items of the next
+            // batch, so the task is looked up per item; it was published
+            // before the item was queued.
+            std::size_t index = 0;
+            while (next(self, index)) {
+                try {
+                    (*_task.load(std::memory_order_acquire))(index);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(_errorMutex);
+                    if (!_error) {
+                        _error = std::current_exception();
+                    }
+                }
+                if (_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    _remaining.notify_all();
+                }
+            }
+        }
+    }
+
+    SerialExecutor::SerialExecutor() : _thread([this]() { work(); }) {
+    }
+
+    SerialExecutor::~SerialExecutor() {
+        _stop.store(true, std::memory_order_release);
+        _posted.fetch_add(1, std::memory_order_release);
+        _posted.notify_all();
+        _thread.join();
+    }
+
+    void SerialExecutor::post(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _tasks.push_back(std::move(task));
+        }
+        _posted.fetch_add(1, std::memory_order_release);
+        _posted.notify_all();
+    }
+
+    void SerialExecutor::work() {
+        std::uint64_t seen = 0;
+        while (true) {
+            std::deque<std::function<void()>> tasks;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                tasks.swap(_tasks);
+            }
+            for (auto &task : tasks) {
+                task();
+            }
+            if (tasks.empty()) {
+                // a post() after the swap has already moved _posted past `seen`
+                if (_stop.load(std::memory_order_acquire)) {
+                    return;
+                }
+                _posted.wait(seen, std::memory_order_acquire);
+                seen = _posted.load(std::memory_order_acquire);
+            }
+        }
+    }
+
+}  // namespace cpp_config
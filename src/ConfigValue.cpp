@@ -0,0 +1,108 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#include "ConfigValue.h"
+
+#include <cerrno>
+#include <cstdlib>
+
+namespace cpp_config {
+
+    ConfigValue::ConfigValue() : _raw(""), _integer(0), _floating(0.0), _boolean(false), _flags(0), _choice(0) {
+    }
+
+    // Mirrors std::stoll / std::stod: leading whitespace and trailing junk are
+    // accepted, out of range values are not. The Exact* flags record whether
+    // the whole text was consumed, which is what typed parameters require.
+    ConfigValue::ConfigValue(const std::string &raw) : _raw(raw), _integer(0), _floating(0.0), _boolean("true" == raw), _flags(0), _choice(0) {
+        const char *begin = _raw.c_str();
+        const char *end   = begin + _raw.size();
+        char *stop        = nullptr;
+
+        errno             = 0;
+        long long integer = std::strtoll(begin, &stop, 10);
+        if (stop != begin && errno != ERANGE) {
+            _integer = integer;
+            _flags |= IntegerFlag;
+            if (stop == end) {
+                _flags |= ExactIntegerFlag;
+            }
+        }
+
+        errno           = 0;
+        double floating = std::strtod(begin, &stop);
+        if (stop != begin && errno != ERANGE) {
+            _floating = floating;
+            _flags |= FloatingFlag;
+            if (stop == end) {
+                _flags |= ExactFloatingFlag;
+            }
+        }
+    }
+
+    ConfigValue::ConfigValue(const std::string &raw, std::int64_t integer)
+        : _raw(raw), _integer(integer), _floating(static_cast<double>(integer)), _boolean(false), _flags(IntegerFlag | FloatingFlag | ExactIntegerFlag | ExactFloatingFlag), _choice(0) {
+    }
+
+    ConfigValue::ConfigValue(const std::string &raw, double floating)
+        : _raw(raw), _integer(0), _floating(floating), _boolean(false), _flags(FloatingFlag | ExactFloatingFlag), _choice(0) {
+    }
+
+    ConfigValue::ConfigValue(const std::string &raw, std::chrono::nanoseconds duration)
+        : _raw(raw), _integer(duration.count()), _floating(0.0), _boolean(false), _flags(DurationFlag), _choice(0) {
+    }
+
+    ConfigValue::ConfigValue(const std::string &raw, const Parsed &parsed)
+        : _raw(raw), _integer(parsed.integer), _floating(parsed.floating), _boolean(parsed.boolean), _flags(parsed.flags), _choice(parsed.choice) {
+    }
+
+    ConfigValue::ConfigValue(const std::string &raw, Choice choice) : ConfigValue(raw) {
+        _flags |= ChoiceFlag;
+        _choice = choice.index;
+    }
+
+    const std::string &ConfigValue::raw() const {
+        return _raw;
+    }
+
+    ConfigValue::Parsed ConfigValue::parsed() const {
+        return {_integer, _floating, _boolean, _flags, _choice};
+    }
+
+    bool ConfigValue::holds(Type type) const {
+        switch (type) {
+            case Type::String:
+                return true;
+            case Type::Bool:
+                return "true" == _raw || "false" == _raw;
+            case Type::Integer:
+                return _flags & ExactIntegerFlag;
+            case Type::Floating:
+                return _flags & ExactFloatingFlag;
+        }
+        return false;
+    }
+
+    const char *toString(ConfigValue::Type type) {
+        switch (type) {
+            case ConfigValue::Type::String:
+                return "string";
+            case ConfigValue::Type::Bool:
+                return "bool";
+            case ConfigValue::Type::Integer:
+                return "integer";
+            case ConfigValue::Type::Floating:
+                return "floating point number";
+        }
+        return "unknown";
+    }
+
+}  // namespace cpp_config
@@ -0,0 +1,113 @@
+/*
+ * World VTT
+ *
+ * Copyright (C) 2025, Asar Miniatures
+ * All rights reserved.
+ *
+ * This file is part of the [Project Name] project. It may be used, modified,
+ * and distributed under the terms specified by the copyright holder.
+ *
+ */
+
+#include "ConfigWatcher.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include "ConfigExceptions.h"
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace cpp_config {
+
+#if defined(__linux__)
+    FileWatcher::FileWatcher(const std::string &path, std::chrono::milliseconds debounce, std::function<void()> onChange)
+        : _debounce(debounce), _onChange(std::move(onChange)), _inotifyFd(-1), _stopFd(-1) {
+        size_t slash = path.find_last_of('/');
+        _directory   = slash == std::string::npos ? "." : path.substr(0, slash == 0 ? 1 : slash);
+        _fileName    = slash == std::string::npos ? path : path.substr(slash + 1);
+
+        _inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        _stopFd    = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (_inotifyFd < 0 || _stopFd < 0 || inotify_add_watch(_inotifyFd, _directory.c_str(), IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE) < 0) {
+            std::string reason = std::strerror(errno);
+            if (_inotifyFd >= 0) close(_inotifyFd);
+            if (_stopFd >= 0) close(_stopFd);
+            throw cpp_config::ConfigurationError("Cannot watch `" + path + "`: " + reason);
+        }
+        _thread = std::thread(&FileWatcher::run, this);
+    }
+
+    FileWatcher::~FileWatcher() {
+        std::uint64_t one = 1;
+        if (write(_stopFd, &one, sizeof(one)) < 0) {
+            // eventfd writes only fail on counter overflow, the thread still wakes up
+        }
+        _thread.join();
+        close(_inotifyFd);
+        close(_stopFd);
+    }
+
+    void FileWatcher::run() {
+        alignas(inotify_event) char buffer[4096];
+        bool pending = false;
+        auto deadline = std::chrono::steady_clock::now();
+
+        while (true) {
+            int timeout = -1;
+            if (pending) {
+                auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+                timeout   = left.count() > 0 ? static_cast<int>(left.count()) : 0;
+            }
+
+            pollfd fds[2] = {{_inotifyFd, POLLIN, 0}, {_stopFd, POLLIN, 0}};
+            int ready     = poll(fds, 2, timeout);
+            if (ready < 0 && errno != EINTR) {
+                return;
+            }
+            if (fds[1].revents & POLLIN) {
+                return;
+            }
+
+            if (fds[0].revents & POLLIN) {
+                ssize_t length;
+                while ((length = read(_inotifyFd, buffer, sizeof(buffer))) > 0) {
+                    for (char *ptr = buffer; ptr < buffer + length;) {
+                        const inotify_event *event = reinterpret_cast<const inotify_event *>(ptr);
+                        if (event->len > 0 && _fileName == event->name) {
+                            pending  = true;
+                            deadline = std::chrono::steady_clock::now() + _debounce;
+                        }
+                        ptr += sizeof(inotify_event) + event->len;
+                    }
+                }
+            }
+
+            if (pending && std::chrono::steady_clock::now() >= deadline) {
+                pending = false;
+                _onChange();
+            }
+        }
+    }
+#else
+    FileWatcher::FileWatcher(const std::string &path, std::chrono::milliseconds debounce, std::function<void()> onChange)
+        : _debounce(debounce), _onChange(std::move(onChange)), _inotifyFd(-1), _stopFd(-1) {
+        throw cpp_config::ConfigurationError("Watching `" + path + "` is only supported on Linux");
+    }
+
+    FileWatcher::~FileWatcher() {
+    }
+
+    void FileWatcher::run() {
+    }
+#endif
+
+}  // namespace cpp_config
@@ -5,15 +5,25 @@
 #include <gtest/gtest.h>
 
 #include <fstream>
+#include <future>
+#include <map>
 #include <memory>
+#include <memory_resource>
+#include <sstream>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include <cstdio>     // std::remove
+#include <fcntl.h>    // AT_FDCWD
+#include <sys/stat.h> // stat, utimensat
 
 #include "Config.h"
 #include "ConfigParameter.h"
 #include "ConfigChoice.h"
 #include "ConfigExceptions.h"
+#include "ConfigFile.h"
+#include "ConfigNameIndex.h"
+#include "ConfigNumber.h"
 
 using namespace cpp_config;
 
@@ -30,6 +40,31 @@ enum class TestParam
 // Skrót na konfigurację testową
 using TestConfig = Config<TestParam>;
 
+// Gęsty enum z `Count` -> płaskie przechowywanie w tablicy
+enum class DenseParam
+{
+    Port,
+    Host,
+    Count,
+};
+
+using DenseConfig = Config<DenseParam>;
+
+// Parametry w arenie należącej do Config – get() zwraca referencję
+enum class ArenaParam
+{
+    Port,
+    Mode,
+    Count,
+};
+
+template <>
+struct cpp_config::ConfigArenaTraits<ArenaParam> {
+        static constexpr bool enabled = true;
+};
+
+using ArenaConfig = Config<ArenaParam>;
+
 // -----------------------------------------
 //  Definicja statycznego _confFileName
 //  (inaczej będzie undefined symbol)
@@ -37,6 +72,10 @@ using TestConfig = Config<TestParam>;
 namespace cpp_config {
 template<>
 const std::string Config<TestParam>::_confFileName = "test_config.cfg";
+template<>
+const std::string Config<DenseParam>::_confFileName = "test_dense_config.cfg";
+template<>
+const std::string Config<ArenaParam>::_confFileName = "test_arena_config.cfg";
 }  // namespace cpp_config
 
 // Pomocnicza funkcja – sprzątanie singletona między testami
@@ -155,6 +194,54 @@ TEST(ConfigParameterTest, AsUnsupportedTypeThrows)
     EXPECT_THROW(p.as<std::vector<int>>(), std::invalid_argument);
 }
 
+TEST(ConfigParameterTest, AsEnumRequiresChoice)
+{
+    enum class Level
+    {
+        Low,
+    };
+    ConfigParameter p("x", "d", "0");
+
+    // enum czyta tylko wybór z listy
+    EXPECT_THROW(p.as<Level>(), std::invalid_argument);
+}
+
+TEST(ConfigParameterTest, AsFollowsSet)
+{
+    ConfigParameter p("num", "d", "1");
+
+    // Wartość jest parsowana raz w set(), as<T>() zwraca gotowy wynik
+    p.set("2.5");
+    EXPECT_DOUBLE_EQ(p.as<double>(), 2.5);
+    EXPECT_EQ(p.as<int>(), 2);  // zgodnie z std::stoll
+    EXPECT_EQ(p.as<std::string>(), "2.5");
+
+    p.set("true");
+    EXPECT_TRUE(p.as<bool>());
+    EXPECT_THROW(p.as<int>(), std::invalid_argument);
+}
+
+TEST(ConfigParameterTest, TypedParameterRejectsInvalidValue)
+{
+    ConfigParameter p("port", "TCP port", "8080", ConfigValue::Type::Integer);
+
+    // Błąd parsowania zgłaszany przy set(), a nie przy pierwszym odczycie
+    EXPECT_THROW(p.set("80abc"), ConfigurationError);
+    EXPECT_THROW(p.set("3.5"), ConfigurationError);
+    EXPECT_EQ(p.as<int>(), 8080);  // wartość bez zmian
+
+    EXPECT_NO_THROW(p.set("9000"));
+    EXPECT_EQ(p.as<int>(), 9000);
+    EXPECT_EQ(p.type(), ConfigValue::Type::Integer);
+}
+
+TEST(ConfigParameterTest, TypedParameterRejectsInvalidDefault)
+{
+    EXPECT_THROW(ConfigParameter("flag", "d", "yes", ConfigValue::Type::Bool), ConfigurationError);
+    EXPECT_THROW(ConfigParameter("ratio", "d", "", ConfigValue::Type::Floating), ConfigurationError);
+    EXPECT_NO_THROW(ConfigParameter("ratio", "d", "0.5", ConfigValue::Type::Floating));
+}
+
 // ===================================================
 //  TESTY: ConfigChoice
 // ===================================================
@@ -193,6 +280,77 @@ TEST(ConfigChoiceTest, SetRejectsNotAllowedValue)
     EXPECT_EQ(c.value(), "red");  // wartość powinna pozostać bez zmian
 }
 
+TEST(ConfigChoiceTest, ConstructorRejectsNotAllowedDefault)
+{
+    std::vector<std::string> choices{"red", "green", "blue"};
+    EXPECT_THROW(ConfigChoice("color", "Color", "yellow", choices), ConfigurationError);
+}
+
+enum class Color
+{
+    Red,
+    Green,
+    Blue,
+};
+
+TEST(ConfigChoiceTest, IndexFollowsValue)
+{
+    std::vector<std::string> choices{"red", "green", "blue"};
+    ConfigChoice c("color", "Color", "green", choices);
+
+    EXPECT_EQ(c.index(), 1u);
+    EXPECT_EQ(c.choice(), "green");
+    EXPECT_EQ(c.as<Color>(), Color::Green);
+
+    c.set("blue");
+    EXPECT_EQ(c.index(), 2u);
+    EXPECT_EQ(c.as<Color>(), Color::Blue);
+    EXPECT_EQ(c.as<std::string>(), "blue");
+
+    // odrzucona wartość nie zmienia indeksu
+    EXPECT_THROW(c.set("yellow"), ConfigurationError);
+    EXPECT_EQ(c.as<Color>(), Color::Blue);
+}
+
+TEST(ConfigChoiceTest, CopiesShareInternedChoices)
+{
+    std::vector<std::string> choices{"red", "green", "blue"};
+    ConfigChoice c("color", "Color", "red", choices);
+
+    auto copy = std::static_pointer_cast<ConfigChoice>(c.clone());
+    copy->set("blue");
+
+    EXPECT_EQ(&copy->choices(), &c.choices());
+    EXPECT_EQ(c.as<Color>(), Color::Red);
+    EXPECT_EQ(copy->as<Color>(), Color::Blue);
+}
+
+TEST(ConfigChoiceTest, NumericChoicesKeepParsedValues)
+{
+    ConfigChoice c("level", "Level", "1", {"1", "2", "3"});
+
+    // wartości listy są parsowane raz, przy jej internowaniu
+    c.set("3");
+    EXPECT_EQ(c.as<int>(), 3);
+    EXPECT_EQ(c.index(), 2u);
+}
+
+TEST(ConfigChoiceTest, ConfigValueReadsEnum)
+{
+    ResetConfig();
+    auto& cfg = TestConfig::instance();
+    cfg.addParam(TestParam::Difficulty, std::make_shared<ConfigChoice>("color", "Color", "green", std::vector<std::string>{"red", "green", "blue"}));
+
+    // wybór jest zapisany w wartości, więc nie trzeba rzutować na ConfigChoice
+    EXPECT_EQ(cfg.value<Color>(TestParam::Difficulty), Color::Green);
+    cfg.set(TestParam::Difficulty, "blue");
+    EXPECT_EQ(cfg.value<Color>(TestParam::Difficulty), Color::Blue);
+    EXPECT_EQ(cfg.snapshot()->value<Color>(TestParam::Difficulty), Color::Blue);
+    EXPECT_EQ(cfg.value<std::string>(TestParam::Difficulty), "blue");
+
+    ResetConfig();
+}
+
 // ===================================================
 //  TESTY: Config<Enum> – logika rejestracji i odczytu
 // ===================================================
@@ -233,6 +391,391 @@ TEST(ConfigTest, ValueThrowsForNotRegistered)
     );
 }
 
+TEST(ConfigTest, FindByName)
+{
+    ResetConfig();
+    auto& cfg = TestConfig::instance();
+
+    cfg.addParam(TestParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "8080"));
+    cfg.freeze();
+
+    EXPECT_EQ(cfg.findByName("port"), TestParam::Port);
+    EXPECT_FALSE(cfg.findByName("host").has_value());
+    EXPECT_FALSE(cfg.findByName("por").has_value());
+
+    // Indeks jest przebudowywany po rejestracji kolejnego parametru
+    cfg.addParam(TestParam::Host, std::make_shared<ConfigParameter>("host", "Server host", ""));
+    EXPECT_EQ(cfg.findByName(std::string_view("host")), TestParam::Host);
+
+    ResetConfig();
+    EXPECT_FALSE(cfg.findByName("port").has_value());
+}
+
+TEST(NameIndexTest, ResolvesManyNames)
+{
+    std::map<std::string, int, std::less<>> names;
+    for (int i = 0; i < 1000; ++i) {
+        names["param_" + std::to_string(i)] = i;
+    }
+    NameIndex<int> index(names);
+
+    EXPECT_EQ(index.size(), 1000u);
+    for (int i = 0; i < 1000; ++i) {
+        const int* key = index.find("param_" + std::to_string(i));
+        ASSERT_NE(key, nullptr);
+        EXPECT_EQ(*key, i);
+    }
+    EXPECT_EQ(index.find("param_1000"), nullptr);
+    EXPECT_EQ(index.find(""), nullptr);
+}
+
+// ===================================================
+//  TESTY: Config<Enum> – płaskie przechowywanie (enum z `Count`)
+// ===================================================
+
+static_assert(std::is_same_v<ConfigStorage<DenseParam, int>, FlatStorage<DenseParam, int>>);
+static_assert(std::is_same_v<ConfigStorage<TestParam, int>, MapStorage<TestParam, int>>);
+
+TEST(ConfigFlatStorageTest, AddParamAndGetValue)
+{
+    auto& cfg = DenseConfig::instance();
+    cfg.clear();
+
+    cfg.addParam(DenseParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "8080"));
+
+    EXPECT_EQ(cfg.value<int>(DenseParam::Port), 8080);
+    EXPECT_EQ(cfg.get(DenseParam::Port)->name(), "port");
+    EXPECT_THROW(
+        cfg.addParam(DenseParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "9000")),
+        DenseConfig::ParameterAlreadyRegistered
+    );
+
+    // niezarejestrowany klucz i klucz spoza tablicy -> std::out_of_range
+    EXPECT_THROW(cfg.value<std::string>(DenseParam::Host), std::out_of_range);
+    EXPECT_THROW(cfg.value<int>(static_cast<DenseParam>(42)), std::out_of_range);
+}
+
+TEST(ConfigFlatStorageTest, LoadFromFileAssignsValuesFromFile)
+{
+    auto& cfg = DenseConfig::instance();
+    cfg.clear();
+
+    cfg.addParam(DenseParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "0"));
+    cfg.addParam(DenseParam::Host, std::make_shared<ConfigParameter>("host", "Server host", ""));
+
+    {
+        std::ofstream out("test_dense_config.cfg");
+        out << "port=9000\n";
+        out << "host=localhost\n";
+    }
+
+    cfg.loadFromFile();
+
+    EXPECT_EQ(cfg.value<int>(DenseParam::Port), 9000);
+    EXPECT_EQ(cfg.value<std::string>(DenseParam::Host), "localhost");
+
+    std::remove("test_dense_config.cfg");
+}
+
+// ===================================================
+//  TESTY: niezależne instancje Config ze wspólnym schematem
+// ===================================================
+
+static std::shared_ptr<const DenseConfig::Schema> MakeDenseSchema()
+{
+    return DenseConfig::Schema::Builder()
+        .add(DenseParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "8080", ConfigValue::Type::Integer))
+        .add(DenseParam::Host, std::make_shared<ConfigParameter>("host", "Server host", "localhost"))
+        .build();
+}
+
+TEST(ConfigInstanceTest, InstancesShareSchemaAndLoadOwnFiles)
+{
+    auto schema = MakeDenseSchema();
+    DenseConfig tenantA(schema, "test_tenant_a.cfg");
+    DenseConfig tenantB(schema, "test_tenant_b.cfg");
+
+    {
+        std::ofstream out("test_tenant_a.cfg");
+        out << "port=9001\n";
+    }
+    {
+        std::ofstream out("test_tenant_b.cfg");
+        out << "port=9002\nhost=b.example\n";
+    }
+    tenantA.loadFromFile();
+    tenantB.loadFromFile();
+
+    EXPECT_EQ(tenantA.value<int>(DenseParam::Port), 9001);
+    EXPECT_EQ(tenantA.value<std::string>(DenseParam::Host), "localhost");
+    EXPECT_EQ(tenantB.value<int>(DenseParam::Port), 9002);
+    EXPECT_EQ(tenantB.value<std::string>(DenseParam::Host), "b.example");
+
+    // schemat i niezmienione parametry są wspólne
+    EXPECT_EQ(tenantA.schema(), tenantB.schema());
+    EXPECT_EQ(tenantA.get(DenseParam::Host), schema->params().at(DenseParam::Host));
+    EXPECT_EQ(tenantA.findByName("host"), DenseParam::Host);
+    EXPECT_EQ(tenantA.path(), "test_tenant_a.cfg");
+
+    std::remove("test_tenant_a.cfg");
+    std::remove("test_tenant_b.cfg");
+}
+
+TEST(ConfigInstanceTest, InstancesAreIndependentOfSingleton)
+{
+    auto& singleton = DenseConfig::instance();
+    singleton.clear();
+    singleton.addParam(DenseParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "1"));
+
+    DenseConfig tenant(MakeDenseSchema(), "test_tenant.cfg");
+    tenant.set(DenseParam::Port, "2");
+
+    EXPECT_EQ(singleton.value<int>(DenseParam::Port), 1);
+    EXPECT_EQ(tenant.value<int>(DenseParam::Port), 2);
+    EXPECT_EQ(singleton.path(), "test_dense_config.cfg");
+
+    singleton.clear();
+}
+
+TEST(ConfigInstanceTest, AddParamCopiesSharedSchema)
+{
+    enum class Local
+    {
+        A,
+        B,
+    };
+    auto schema = Config<Local>::Schema::Builder().add(Local::A, std::make_shared<ConfigParameter>("a", "d", "1")).build();
+    Config<Local> first(schema, "test_local_first.cfg");
+    Config<Local> second(schema, "test_local_second.cfg");
+
+    first.addParam(Local::B, std::make_shared<ConfigParameter>("b", "d", "2"));
+
+    EXPECT_EQ(first.findByName("b"), Local::B);
+    EXPECT_EQ(second.findByName("b"), std::nullopt);
+    EXPECT_EQ(second.schema(), schema);
+    EXPECT_THROW(second.value<int>(Local::B), std::out_of_range);
+}
+
+TEST(ConfigInstanceTest, RegistrationsArePublishedOnce)
+{
+    enum class Many : int
+    {
+    };
+    Config<Many> cfg(Config<Many>::Schema::Builder().build(), "test_local_many.cfg");
+    const std::uint64_t before = cfg.generation();
+
+    // addParam() nie kopiuje tabeli – wszystko trafia do jednej migawki
+    for (int i = 0; i < 2000; ++i) {
+        cfg.addParam(static_cast<Many>(i), std::make_shared<ConfigParameter>("key" + std::to_string(i), "d", std::to_string(i)));
+    }
+    EXPECT_EQ(cfg.value<int>(static_cast<Many>(1999)), 1999);
+    EXPECT_EQ(cfg.generation(), before + 1);
+    EXPECT_EQ(cfg.source(static_cast<Many>(7)).kind, ValueSource::Kind::Default);
+
+    // kolejna rejestracja dokłada tylko nowy klucz, wartości zostają
+    cfg.set(static_cast<Many>(0), "100");
+    cfg.addParam(static_cast<Many>(2000), std::make_shared<ConfigParameter>("key2000", "d", "2000"));
+    EXPECT_EQ(cfg.value<int>(static_cast<Many>(2000)), 2000);
+    EXPECT_EQ(cfg.value<int>(static_cast<Many>(0)), 100);
+    EXPECT_EQ(cfg.generation(), before + 3);
+}
+
+TEST(ConfigInstanceTest, BuilderRejectsDuplicateKeys)
+{
+    DenseConfig::Schema::Builder builder;
+    builder.add(DenseParam::Port, std::make_shared<ConfigParameter>("port", "d", "1"));
+    EXPECT_THROW(builder.add(DenseParam::Port, std::make_shared<ConfigParameter>("port", "d", "2")), DenseConfig::ParameterAlreadyRegistered);
+}
+
+// ===================================================
+//  TESTY: Config<Enum> – parametry w arenie
+// ===================================================
+
+static_assert(std::is_same_v<decltype(ArenaConfig::instance().get(ArenaParam::Port)), ParameterRef<ArenaParam>>);
+static_assert(std::is_same_v<decltype(DenseConfig::instance().get(DenseParam::Port)), std::shared_ptr<const ConfigParameter>>);
+
+static void SetupArenaConfig()
+{
+    auto& cfg = ArenaConfig::instance();
+    cfg.clear();
+    cfg.addParam(ArenaParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "8080", ConfigValue::Type::Integer));
+    cfg.addParam(ArenaParam::Mode, std::make_shared<ConfigChoice>("mode", "Mode", "auto", std::vector<std::string>{"auto", "manual"}));
+}
+
+TEST(ConfigArenaTest, GetReturnsReferenceThatSurvivesReloads)
+{
+    SetupArenaConfig();
+    auto& cfg = ArenaConfig::instance();
+
+    // stara wartość żyje tak długo, jak migawka trzymana przez referencję
+    auto before = cfg.get(ArenaParam::Port);
+    EXPECT_EQ(before->value(), "8080");
+
+    {
+        std::ofstream out("test_arena_config.cfg");
+        out << "port=9000\n";
+        out << "mode=manual\n";
+    }
+    cfg.loadFromFile();
+
+    // nowa wartość jest nowym obiektem w arenie, stary pozostaje nienaruszony
+    EXPECT_EQ(cfg.value<int>(ArenaParam::Port), 9000);
+    EXPECT_EQ(cfg.get(ArenaParam::Port)->value(), "9000");
+    EXPECT_EQ(before->value(), "8080");
+    EXPECT_EQ(before.snapshot().value<int>(ArenaParam::Port), 8080);
+
+    // typ dynamiczny jest zachowany przy kopiowaniu do areny
+    auto current     = cfg.get(ArenaParam::Mode);
+    const auto* mode = dynamic_cast<const ConfigChoice*>(current.get());
+    ASSERT_NE(mode, nullptr);
+    EXPECT_EQ(mode->choice(), "manual");
+    EXPECT_THROW(cfg.set(ArenaParam::Mode, "off"), ConfigurationError);
+    EXPECT_EQ(cfg.value<std::string>(ArenaParam::Mode), "manual");
+
+    std::remove("test_arena_config.cfg");
+}
+
+TEST(ConfigArenaTest, SnapshotKeepsArenaAliveAfterClear)
+{
+    SetupArenaConfig();
+    auto& cfg = ArenaConfig::instance();
+    cfg.set(ArenaParam::Port, "9100");
+
+    auto snapshot = cfg.snapshot();
+    auto port     = cfg.get(ArenaParam::Port);
+    cfg.clear();
+
+    EXPECT_EQ(snapshot->value<int>(ArenaParam::Port), 9100);
+    EXPECT_EQ(snapshot->get(ArenaParam::Port)->name(), "port");
+    EXPECT_EQ(port->as<int>(), 9100);
+}
+
+TEST(ConfigArenaTest, GetKeepsReplacedValueWhileOtherInstancesAreRead)
+{
+    auto schema = ArenaConfig::Schema::Builder()
+                      .add(ArenaParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "8080", ConfigValue::Type::Integer))
+                      .build();
+    // więcej instancji niż miejsc w pamięci podręcznej wątku, więc
+    // odczyty innych instancji wypierają migawkę pierwszej
+    std::vector<std::unique_ptr<ArenaConfig>> configs;
+    for (int i = 0; i < 33; ++i) {
+        configs.push_back(std::make_unique<ArenaConfig>(schema, "test_arena_config.cfg"));
+    }
+
+    auto port = configs[0]->get(ArenaParam::Port);
+    configs[0]->set(ArenaParam::Port, "9000");
+    configs[0]->set(ArenaParam::Port, "9001");
+    for (std::size_t i = 1; i < configs.size(); ++i) {
+        EXPECT_EQ(configs[i]->value<int>(ArenaParam::Port), 8080);
+    }
+    EXPECT_EQ(port->value(), "8080");
+    EXPECT_EQ(configs[0]->get(ArenaParam::Port)->as<int>(), 9001);
+}
+
+TEST(ConfigArenaTest, CompactKeepsCurrentValues)
+{
+    SetupArenaConfig();
+    auto& cfg = ArenaConfig::instance();
+    for (int port = 8000; port < 8100; ++port) {
+        cfg.set(ArenaParam::Port, std::to_string(port));
+    }
+    auto old = cfg.snapshot();
+
+    cfg.compact();
+
+    EXPECT_EQ(cfg.value<int>(ArenaParam::Port), 8099);
+    EXPECT_EQ(cfg.value<std::string>(ArenaParam::Mode), "auto");
+    EXPECT_NE(cfg.get(ArenaParam::Port).get(), old->get(ArenaParam::Port));
+    EXPECT_EQ(old->value<int>(ArenaParam::Port), 8099);
+}
+
+// Parametr liczący swoje żywe kopie, także te w arenie
+class CountedParameter : public ConfigParameter
+{
+public:
+    static inline int live = 0;
+
+    using ConfigParameter::ConfigParameter;
+    CountedParameter(const CountedParameter& rhs) : ConfigParameter(rhs) { ++live; }
+    ~CountedParameter() override { --live; }
+
+    std::shared_ptr<ConfigParameter> clone() const override
+    {
+        return std::make_shared<CountedParameter>(*this);
+    }
+    ConfigParameter* cloneInto(std::pmr::memory_resource& memory) const override
+    {
+        return std::pmr::polymorphic_allocator<>(&memory).new_object<CountedParameter>(*this);
+    }
+};
+
+TEST(ConfigArenaTest, ReplacedValuesAreReclaimedWithTheirSnapshots)
+{
+    auto& cfg = ArenaConfig::instance();
+    cfg.clear();
+    cfg.addParam(ArenaParam::Port, std::make_shared<CountedParameter>("port", "TCP port", "8080", ConfigValue::Type::Integer));
+    cfg.addParam(ArenaParam::Mode, std::make_shared<ConfigChoice>("mode", "Mode", "auto", std::vector<std::string>{"auto", "manual"}));
+    std::vector<int> seen;
+    cfg.onChange(ArenaParam::Port, [&seen](const ConfigParameter& previous, const ConfigParameter& current) {
+        seen.push_back(current.as<int>() - previous.as<int>());
+    });
+
+    // referencje z get() trzymają swoją migawkę, a z nią starą wartość
+    // zmienianego parametru
+    const ConfigParameter* mode = nullptr;
+    {
+        auto unchanged = cfg.get(ArenaParam::Mode);
+        auto port      = cfg.get(ArenaParam::Port);
+        mode           = unchanged.get();
+        for (int value = 8081; value < 8481; ++value) {
+            cfg.set(ArenaParam::Port, std::to_string(value));
+            EXPECT_THROW(cfg.set(ArenaParam::Port, "x"), ConfigurationError);
+        }
+        EXPECT_EQ(cfg.value<int>(ArenaParam::Port), 8480);
+        EXPECT_EQ(unchanged->value(), "auto");
+        EXPECT_EQ(port->description(), "TCP port");
+        EXPECT_EQ(port->as<int>(), 8080);
+        ASSERT_EQ(seen.size(), 400u);
+        EXPECT_EQ(seen.front(), 1);
+        EXPECT_EQ(seen.back(), 1);
+
+        // zastąpione i odrzucone kopie są zwalniane bez compact()
+        EXPECT_LT(CountedParameter::live, 10);
+    }
+    cfg.set(ArenaParam::Port, "8481");
+    cfg.set(ArenaParam::Port, "8482");
+    EXPECT_EQ(cfg.value<int>(ArenaParam::Port), 8482);
+    EXPECT_LT(CountedParameter::live, 6);
+    EXPECT_EQ(cfg.get(ArenaParam::Mode).get(), mode);
+
+    cfg.clear();
+}
+
+TEST(ConfigArenaTest, StrictLoadDiscardsUnpublishedCopies)
+{
+    auto& cfg = ArenaConfig::instance();
+    cfg.clear();
+    cfg.addParam(ArenaParam::Port, std::make_shared<CountedParameter>("port", "TCP port", "8080", ConfigValue::Type::Integer));
+    cfg.addParam(ArenaParam::Mode, std::make_shared<ConfigChoice>("mode", "Mode", "auto", std::vector<std::string>{"auto", "manual"}));
+    cfg.freeze();
+    const int before = CountedParameter::live;
+
+    // poprawny port jest kopiowany do areny, ale odrzucony tryb cofa całe wczytanie
+    {
+        std::ofstream out("test_arena_config.cfg");
+        out << "port=9000\n";
+        out << "mode=off\n";
+    }
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_THROW(cfg.loadFromFile(LoadMode::Strict), ConfigLoadError);
+    }
+    EXPECT_EQ(cfg.value<int>(ArenaParam::Port), 8080);
+    EXPECT_EQ(CountedParameter::live, before);
+
+    std::remove("test_arena_config.cfg");
+    cfg.clear();
+}
+
 // ===================================================
 //  TESTY: Config<Enum> – loadFromFile()
 // ===================================================
@@ -306,9 +849,351 @@ TEST(ConfigTest, LoadFromFileIgnoresUnknownKeysAndBadLines)
     std::remove("test_config.cfg");
 }
 
+TEST(ConfigTest, LoadFromFileLineWithoutEqualSignDoesNotSetParameter)
+{
+    ResetConfig();
+    auto& cfg = TestConfig::instance();
+
+    cfg.addParam(
+        TestParam::Host,
+        std::make_shared<ConfigParameter>("host", "Server host", "localhost")
+    );
+
+    {
+        std::ofstream out("test_config.cfg");
+        out << "host\n";  // sama nazwa parametru bez '=' -> linia ignorowana
+    }
+
+    cfg.loadFromFile();
+
+    EXPECT_EQ(cfg.value<std::string>(TestParam::Host), "localhost");
+
+    std::remove("test_config.cfg");
+}
+
+TEST(ConfigTest, LoadFromFileReadsLargeMappedFile)
+{
+    ResetConfig();
+    auto& cfg = TestConfig::instance();
+
+    cfg.addParam(
+        TestParam::Port,
+        std::make_shared<ConfigParameter>("port", "TCP port", "0")
+    );
+
+    {
+        std::ofstream out("test_config.cfg");
+        for (int i = 0; i < 20000; ++i) {
+            out << "unknown_" << i << "=value_" << i << "\n";
+        }
+        out << "port=4321";  // ostatnia linia bez znaku nowej linii
+    }
+
+    // Duży plik jest mapowany w pamięci zamiast wczytywany do bufora
+    EXPECT_TRUE(MappedFile("test_config.cfg").mapped());
+
+    cfg.loadFromFile();
+
+    EXPECT_EQ(cfg.value<int>(TestParam::Port), 4321);
+
+    std::remove("test_config.cfg");
+}
+
+TEST(ConfigTest, SaveToFileWritesParametersWithDescriptions)
+{
+    ResetConfig();
+    auto& cfg = TestConfig::instance();
+
+    cfg.addParam(
+        TestParam::Port,
+        std::make_shared<ConfigParameter>("port", "TCP port", "8080")
+    );
+    cfg.addParam(
+        TestParam::Difficulty,
+        std::make_shared<ConfigChoice>(
+            "difficulty",
+            "Game difficulty",
+            "easy",
+            std::vector<std::string>{"easy", "medium", "hard"}
+        )
+    );
+    cfg.set(TestParam::Port, "9000");
+
+    cfg.saveToFile();
+
+    std::stringstream content;
+    content << std::ifstream("test_config.cfg").rdbuf();
+    EXPECT_EQ(content.str(),
+              "# TCP port\n"
+              "port=9000\n"
+              "\n"
+              "# Game difficulty; /easy/medium/hard/\n"
+              "difficulty=easy\n"
+              "\n");
+
+    // Zapisany plik wczytuje się z powrotem do tych samych wartości
+    ResetConfig();
+    cfg.addParam(TestParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "0"));
+    cfg.loadFromFile();
+    EXPECT_EQ(cfg.value<int>(TestParam::Port), 9000);
+
+    std::remove("test_config.cfg");
+}
+
+TEST(ConfigTest, SaveToFileAsync)
+{
+    ResetConfig();
+    auto& cfg = TestConfig::instance();
+
+    cfg.addParam(
+        TestParam::Host,
+        std::make_shared<ConfigParameter>("host", "Server host", "localhost")
+    );
+
+    std::remove("test_config.cfg");
+    std::future<void> saved = cfg.saveToFileAsync();
+    saved.get();
+
+    std::stringstream content;
+    content << std::ifstream("test_config.cfg").rdbuf();
+    EXPECT_NE(content.str().find("host=localhost\n"), std::string::npos);
+
+    // porzucona przyszłość nie blokuje, zapisy wykonują się po kolei
+    cfg.set(TestParam::Host, "first");
+    (void)cfg.saveToFileAsync();
+    cfg.set(TestParam::Host, "second");
+    cfg.saveToFileAsync().get();
+    std::stringstream last;
+    last << std::ifstream("test_config.cfg").rdbuf();
+    EXPECT_NE(last.str().find("host=second\n"), std::string::npos);
+
+    std::remove("test_config.cfg");
+
+    // błąd zapisu trafia do przyszłości
+    Config<TestParam> missing(cfg.schema(), "no_such_dir/test_config.cfg");
+    EXPECT_THROW(missing.saveToFileAsync().get(), ConfigurationError);
+}
+
+TEST(ConfigTest, MissingFileInUnwritableLocationKeepsDefaults)
+{
+    ResetConfig();
+    auto& cfg = TestConfig::instance();
+    cfg.addParam(TestParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "8080"));
+
+    // brakującego pliku nie da się utworzyć – zostają wartości domyślne
+    Config<TestParam> unwritable(cfg.schema(), "no_such_dir/test_config.cfg");
+    EXPECT_NO_THROW(unwritable.loadFromFile());
+    EXPECT_NO_THROW(unwritable.reload());
+    EXPECT_NO_THROW(unwritable.loadFromFileCached());
+    EXPECT_EQ(unwritable.value<int>(TestParam::Port), 8080);
+}
+
+TEST(ConfigTest, SetRejectsInvalidChoice)
+{
+    ResetConfig();
+    auto& cfg = TestConfig::instance();
+
+    cfg.addParam(
+        TestParam::Difficulty,
+        std::make_shared<ConfigChoice>("difficulty", "Game difficulty", "easy", std::vector<std::string>{"easy", "hard"})
+    );
+
+    EXPECT_THROW(cfg.set(TestParam::Difficulty, "medium"), ConfigurationError);
+    EXPECT_EQ(cfg.value<std::string>(TestParam::Difficulty), "easy");
+    EXPECT_THROW(cfg.set(TestParam::Port, "1"), std::out_of_range);
+}
+
+static void WritePortFile(const std::string& port)
+{
+    std::ofstream out("test_config.cfg");
+    out << "port=" << port << "\n";
+}
+
+// Cofa czas modyfikacji pliku, żeby jego rozmiar i czas były wiarygodne
+static void SettlePortFile(struct timespec* mtime = nullptr)
+{
+    struct stat info;
+    ASSERT_EQ(stat("test_config.cfg", &info), 0);
+    struct timespec times[2] = {info.st_atim, info.st_mtim};
+    if (mtime != nullptr) {
+        times[1] = *mtime;
+    } else {
+        times[1].tv_sec -= 10;
+    }
+    ASSERT_EQ(utimensat(AT_FDCWD, "test_config.cfg", times, 0), 0);
+}
+
+TEST(ConfigTest, LoadFromFileCachedUsesBinaryCache)
+{
+    ResetConfig();
+    auto& cfg = TestConfig::instance();
+    cfg.addParam(TestParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "0"));
+
+    std::remove("test_config.cfg.bin");
+    WritePortFile("9000");
+    SettlePortFile();
+
+    // Pierwsze wczytanie: parsowanie tekstu i zapis cache
+    cfg.loadFromFileCached();
+    EXPECT_EQ(cfg.value<int>(TestParam::Port), 9000);
+    EXPECT_TRUE(std::ifstream("test_config.cfg.bin").is_open());
+
+    // Ustabilizowany plik o tym samym rozmiarze i czasie -> wartość pochodzi z cache, nie z tekstu
+    struct stat before;
+    ASSERT_EQ(stat("test_config.cfg", &before), 0);
+    WritePortFile("9001");
+    SettlePortFile(&before.st_mtim);
+
+    ResetConfig();
+    cfg.addParam(TestParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "0"));
+    cfg.loadFromFileCached();
+    EXPECT_EQ(cfg.value<int>(TestParam::Port), 9000);
+    EXPECT_EQ(cfg.source(TestParam::Port).kind, ValueSource::Kind::File);
+
+    // Zmieniony schemat unieważnia cache
+    ResetConfig();
+    cfg.addParam(TestParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "0", ConfigValue::Type::Integer));
+    cfg.loadFromFileCached();
+    EXPECT_EQ(cfg.value<int>(TestParam::Port), 9001);
+
+    std::remove("test_config.cfg");
+    std::remove("test_config.cfg.bin");
+}
+
+TEST(ConfigTest, LoadFromFileCachedDetectsEditWithinOneTick)
+{
+    ResetConfig();
+    auto& cfg = TestConfig::instance();
+    cfg.addParam(TestParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "0", ConfigValue::Type::Integer));
+
+    std::remove("test_config.cfg.bin");
+    WritePortFile("9000");
+    cfg.loadFromFileCached();
+
+    // świeży plik: ten sam rozmiar i czas nie wystarczą, decyduje hash treści
+    struct stat before;
+    ASSERT_EQ(stat("test_config.cfg", &before), 0);
+    WritePortFile("9001");
+    SettlePortFile(&before.st_mtim);
+    cfg.loadFromFileCached();
+    EXPECT_EQ(cfg.value<int>(TestParam::Port), 9001);
+
+    // ta sama treść -> wartości z cache, już bez ponownego parsowania
+    ResetConfig();
+    cfg.addParam(TestParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "0", ConfigValue::Type::Integer));
+    cfg.loadFromFileCached();
+    EXPECT_EQ(cfg.value<int>(TestParam::Port), 9001);
+    EXPECT_EQ(cfg.get(TestParam::Port)->parsed().parsed().integer, 9001);
+
+    std::remove("test_config.cfg");
+    std::remove("test_config.cfg.bin");
+}
+
+TEST(ConfigTest, LoadFromFileCachedRestoresChoice)
+{
+    ResetConfig();
+    auto& cfg = TestConfig::instance();
+    auto difficulty = [] {
+        return std::make_shared<ConfigChoice>("difficulty", "Game difficulty", "easy", std::vector<std::string>{"easy", "medium", "hard"});
+    };
+    cfg.addParam(TestParam::Difficulty, difficulty());
+
+    std::remove("test_config.cfg.bin");
+    {
+        std::ofstream out("test_config.cfg");
+        out << "difficulty=hard\n";
+    }
+    cfg.loadFromFileCached();
+
+    // indeks wyboru pochodzi z cache, a nie z ponownego parsowania
+    ResetConfig();
+    cfg.addParam(TestParam::Difficulty, difficulty());
+    cfg.loadFromFileCached();
+    EXPECT_EQ(cfg.value<Color>(TestParam::Difficulty), Color::Blue);
+    EXPECT_EQ(cfg.value<std::string>(TestParam::Difficulty), "hard");
+
+    std::remove("test_config.cfg");
+    std::remove("test_config.cfg.bin");
+}
+
+TEST(ConfigTest, LoadFromFileCachedRebuildsAfterParameterClassChange)
+{
+    ResetConfig();
+    auto& cfg = TestConfig::instance();
+    cfg.addParam(TestParam::Port, std::make_shared<ConfigInteger>("port", "TCP port", "0"));
+
+    std::remove("test_config.cfg.bin");
+    WritePortFile("-5");
+    SettlePortFile();
+    cfg.loadFromFileCached();
+    EXPECT_EQ(cfg.value<int>(TestParam::Port), -5);
+
+    // ta sama nazwa, typ i opis, ale inna klasa parametru -> cache jest
+    // odrzucany i wartość z tekstu przechodzi walidację ConfigSize
+    ResetConfig();
+    cfg.addParam(TestParam::Port, std::make_shared<ConfigSize>("port", "TCP port", "0"));
+    EXPECT_THROW(cfg.loadFromFileCached(), ConfigurationError);
+    EXPECT_EQ(cfg.value<int>(TestParam::Port), 0);
+
+    WritePortFile("8KiB");
+    cfg.loadFromFileCached();
+    EXPECT_EQ(cfg.value<int>(TestParam::Port), 8192);
+
+    std::remove("test_config.cfg");
+    std::remove("test_config.cfg.bin");
+}
+
+TEST(ConfigTest, LoadFromFileCachedRejectsOversizedCount)
+{
+    ResetConfig();
+    auto& cfg = TestConfig::instance();
+    cfg.addParam(TestParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "0", ConfigValue::Type::Integer));
+
+    std::remove("test_config.cfg.bin");
+    WritePortFile("9000");
+    SettlePortFile();
+    cfg.loadFromFileCached();
+
+    // Uszkodzony nagłówek: liczba wpisów większa, niż zmieści plik
+    {
+        std::fstream cache("test_config.cfg.bin", std::ios::in | std::ios::out | std::ios::binary);
+        ASSERT_TRUE(cache.is_open());
+        const uint32_t count = 0xFFFFFFFF;
+        cache.seekp(12);  // za magic[8] i version
+        cache.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+
+    // cache jest odrzucany, wartości pochodzą z tekstu
+    ResetConfig();
+    cfg.addParam(TestParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "0", ConfigValue::Type::Integer));
+    EXPECT_NO_THROW(cfg.loadFromFileCached());
+    EXPECT_EQ(cfg.value<int>(TestParam::Port), 9000);
+
+    std::remove("test_config.cfg");
+    std::remove("test_config.cfg.bin");
+}
+
+TEST(ConfigTest, LoadFromFileCachedReparsesModifiedFile)
+{
+    ResetConfig();
+    auto& cfg = TestConfig::instance();
+    cfg.addParam(TestParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "0"));
+
+    std::remove("test_config.cfg.bin");
+    WritePortFile("9000");
+    cfg.loadFromFileCached();
+
+    WritePortFile("12345");  // inny rozmiar pliku
+    cfg.loadFromFileCached();
+    EXPECT_EQ(cfg.value<int>(TestParam::Port), 12345);
+
+    std::remove("test_config.cfg");
+    std::remove("test_config.cfg.bin");
+}
+
 TEST(ConfigTest, SaveToFileCreatesFileIfNotExists)
 {
-    // saveToFile() w Config po prostu otwiera i zamyka plik _confFileName
+    // saveToFile() tworzy plik także dla pustej konfiguracji
     ResetConfig();
     auto& cfg = TestConfig::instance();
 
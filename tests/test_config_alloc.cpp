@@ -0,0 +1,238 @@
+/*
+ * World VTT / cpp_config – tests alokacji na ścieżce odczytu
+ *
+ * Globalne operator new/delete zliczają alokacje bieżącego wątku;
+ * każdy test sprawdza, że odczyt nie wykonuje żadnej alokacji.
+ */
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdio>  // std::remove
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Config.h"
+#include "ConfigChoice.h"
+#include "ConfigParameter.h"
+#include "ConfigShared.h"
+
+using namespace cpp_config;
+
+static thread_local std::size_t g_allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    ++g_allocations;
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+// Liczba alokacji wykonanych przez f w bieżącym wątku
+template <class F>
+static std::size_t CountAllocations(F&& f)
+{
+    std::size_t before = g_allocations;
+    f();
+    return g_allocations - before;
+}
+
+// Napisy dłuższe niż bufor SSO – każda kopia musiałaby alokować
+static const std::string kLongName        = "server.listen_address_with_a_long_name";
+static const std::string kLongDescription = "Address the server listens on, long enough to leave SSO";
+static const std::string kLongValue       = "listen.example.invalid:8080/with/some/path";
+
+enum class AllocParam
+{
+    Port,
+    Ratio,
+    Enabled,
+    Count,
+};
+
+using AllocConfig = Config<AllocParam>;
+
+namespace cpp_config {
+template<>
+const std::string Config<AllocParam>::_confFileName = "test_alloc_config.cfg";
+}  // namespace cpp_config
+
+TEST(AllocationTest, CounterSeesCopies)
+{
+    ConfigParameter p(kLongName, kLongDescription, kLongValue);
+    EXPECT_GT(CountAllocations([&] { ConfigParameter copy(p); }), 0u);
+}
+
+TEST(AllocationTest, ParameterAccessorsDoNotAllocate)
+{
+    ConfigParameter text(kLongName, kLongDescription, kLongValue);
+    ConfigParameter port("port", kLongDescription, "8080", ConfigValue::Type::Integer);
+    ConfigParameter ratio("ratio", kLongDescription, "0.75", ConfigValue::Type::Floating);
+    ConfigParameter flag("flag", kLongDescription, "true", ConfigValue::Type::Bool);
+
+    std::size_t length = 0;
+    EXPECT_EQ(CountAllocations([&] {
+                  length += text.name().size();
+                  length += text.description().size();
+                  length += text.value().size();
+                  length += static_cast<std::size_t>(port.as<int>());
+                  length += static_cast<std::size_t>(ratio.as<double>());
+                  length += flag.as<bool>() ? 1 : 0;
+              }),
+              0u);
+    EXPECT_GT(length, 0u);
+}
+
+TEST(AllocationTest, MoveDoesNotAllocate)
+{
+    ConfigParameter p(kLongName, kLongDescription, kLongValue);
+    ConfigChoice c(kLongName, kLongDescription, kLongValue, {kLongValue, "other"});
+
+    EXPECT_EQ(CountAllocations([&] {
+                  ConfigParameter moved(std::move(p));
+                  ConfigParameter assigned;
+                  assigned = std::move(moved);
+                  ConfigChoice movedChoice(std::move(c));
+              }),
+              0u);
+}
+
+enum class Region
+{
+    North,
+    South,
+};
+
+TEST(AllocationTest, ChoiceReadsDoNotAllocate)
+{
+    ConfigChoice c("region", kLongDescription, "south", {"north", "south"});
+
+    std::size_t sum = 0;
+    EXPECT_EQ(CountAllocations([&] {
+                  sum += c.index();
+                  sum += c.choice().size();
+                  sum += c.description().size();
+                  sum += c.as<Region>() == Region::South ? 1 : 0;
+              }),
+              0u);
+    EXPECT_GT(sum, 0u);
+}
+
+TEST(AllocationTest, ConfigReadsDoNotAllocate)
+{
+    auto& cfg = AllocConfig::instance();
+    cfg.clear();
+    cfg.addParam(AllocParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "8080", ConfigValue::Type::Integer));
+    cfg.addParam(AllocParam::Ratio, std::make_shared<ConfigParameter>("ratio", "Ratio", "0.75", ConfigValue::Type::Floating));
+    cfg.addParam(AllocParam::Enabled, std::make_shared<ConfigParameter>("enabled", "Enabled", "true", ConfigValue::Type::Bool));
+    cfg.freeze();
+    // pierwszy odczyt na wątku zakłada jego pamięć podręczną migawek
+    cfg.value<int>(AllocParam::Port);
+    cfg.findByName("port");
+
+    int port     = 0;
+    double ratio = 0;
+    bool enabled = false;
+    EXPECT_EQ(CountAllocations([&] {
+                  port     = cfg.value<int>(AllocParam::Port);
+                  ratio    = cfg.value<double>(AllocParam::Ratio);
+                  enabled  = cfg.value<bool>(AllocParam::Enabled);
+                  auto key = cfg.findByName("port");
+                  port += key ? 1 : 0;
+                  auto snapshot = cfg.snapshot();
+                  port += snapshot->value<int>(AllocParam::Port);
+                  port += cfg.get(AllocParam::Port)->name().size();
+              }),
+              0u);
+    EXPECT_EQ(port, 8080 + 1 + 8080 + 4);
+    EXPECT_DOUBLE_EQ(ratio, 0.75);
+    EXPECT_TRUE(enabled);
+
+    cfg.clear();
+}
+
+TEST(AllocationTest, SharedReaderNumericReadsDoNotAllocate)
+{
+    auto schema = AllocConfig::Schema::Builder()
+                      .add(AllocParam::Port, std::make_shared<ConfigParameter>("port", kLongValue, "8080", ConfigValue::Type::Integer))
+                      .add(AllocParam::Ratio, std::make_shared<ConfigParameter>("ratio", "Ratio", "0.75", ConfigValue::Type::Floating))
+                      .add(AllocParam::Enabled, std::make_shared<ConfigParameter>(kLongName, kLongDescription, kLongValue))
+                      .build();
+    AllocConfig cfg(schema, "test_alloc_config.cfg");
+    SharedConfigPublisher<AllocParam> publisher(cfg, "/cpp_config_test_alloc_" + std::to_string(::getpid()));
+    SharedConfigReader<AllocParam> reader(schema, publisher.name());
+
+    // tylko odczyt napisu kopiuje tekst ze slotu
+    int port     = 0;
+    double ratio = 0;
+    EXPECT_EQ(CountAllocations([&] {
+                  port  = reader.value<int>(AllocParam::Port);
+                  ratio = reader.value<double>(AllocParam::Ratio);
+              }),
+              0u);
+    EXPECT_EQ(port, 8080);
+    EXPECT_DOUBLE_EQ(ratio, 0.75);
+    EXPECT_EQ(reader.value<std::string>(AllocParam::Enabled), kLongValue);
+    EXPECT_THROW(reader.value<int>(AllocParam::Enabled), std::invalid_argument);
+}
+
+TEST(AllocationTest, UnchangedFileValuesAreNotCopied)
+{
+    auto schema = AllocConfig::Schema::Builder()
+                      .add(AllocParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "8080", ConfigValue::Type::Integer))
+                      .add(AllocParam::Enabled, std::make_shared<ConfigParameter>(kLongName, kLongDescription, kLongValue))
+                      .build();
+    AllocConfig cfg(schema, "test_alloc_config.cfg");
+    cfg.freeze();
+
+    // długa wartość równa bieżącej, powtórzona `lines` razy
+    auto load = [&cfg](int lines) {
+        {
+            std::ofstream out("test_alloc_config.cfg");
+            for (int i = 0; i < lines; ++i) {
+                out << kLongName << " = " << kLongValue << "\n";
+            }
+        }
+        return CountAllocations([&cfg] { cfg.loadFromFile(); });
+    };
+    load(1);
+    // liczba alokacji nie zależy od liczby wierszy; plik mieści się w
+    // jednym fragmencie, więc żaden wiersz nie jest dzielony
+    EXPECT_EQ(load(500), load(10));
+    EXPECT_EQ(cfg.value<std::string>(AllocParam::Enabled), kLongValue);
+
+    std::remove("test_alloc_config.cfg");
+}
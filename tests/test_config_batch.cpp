@@ -0,0 +1,139 @@
+/*
+ * World VTT / cpp_config – tests równoległego wczytywania wielu plików
+ *
+ * Uruchamiać także pod ThreadSanitizerem: make test-tsan
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdio>  // std::remove
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ConfigBatch.h"
+#include "ConfigExceptions.h"
+#include "ConfigParameter.h"
+#include "ConfigThreadPool.h"
+
+using namespace cpp_config;
+
+enum class TenantParam
+{
+    Port,
+    Host,
+    Count,
+};
+
+using TenantConfig = Config<TenantParam>;
+
+static std::shared_ptr<const TenantConfig::Schema> MakeTenantSchema()
+{
+    return TenantConfig::Schema::Builder()
+        .add(TenantParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "0", ConfigValue::Type::Integer))
+        .add(TenantParam::Host, std::make_shared<ConfigParameter>("host", "Server host", ""))
+        .build();
+}
+
+static std::string TenantPath(int tenant)
+{
+    return "test_batch_tenant_" + std::to_string(tenant) + ".cfg";
+}
+
+// ===================================================
+//  TESTY: WorkStealingPool
+// ===================================================
+
+TEST(WorkStealingPoolTest, RunsEveryIndexOnce)
+{
+    WorkStealingPool pool(4);
+    EXPECT_EQ(pool.size(), 4u);
+
+    std::vector<std::atomic<int>> hits(1000);
+    for (int batch = 0; batch < 20; ++batch) {
+        pool.parallelFor(hits.size(), [&hits](std::size_t i) { hits[i].fetch_add(1); });
+    }
+    for (const auto& hit : hits) {
+        EXPECT_EQ(hit.load(), 20);
+    }
+
+    pool.parallelFor(0, [](std::size_t) { FAIL(); });
+}
+
+TEST(WorkStealingPoolTest, RethrowsTaskErrorAfterBatch)
+{
+    WorkStealingPool pool(3);
+    std::atomic<int> ran{0};
+
+    EXPECT_THROW(pool.parallelFor(100,
+                                  [&ran](std::size_t i) {
+                                      ran.fetch_add(1);
+                                      if (i == 42) {
+                                          throw std::runtime_error("boom");
+                                      }
+                                  }),
+                 std::runtime_error);
+    // błąd jednego zadania nie przerywa pozostałych
+    EXPECT_EQ(ran.load(), 100);
+
+    // pula nadaje się do dalszego użycia
+    ran = 0;
+    pool.parallelFor(10, [&ran](std::size_t) { ran.fetch_add(1); });
+    EXPECT_EQ(ran.load(), 10);
+}
+
+// ===================================================
+//  TESTY: loadBatch()
+// ===================================================
+
+TEST(LoadBatchTest, LoadsEveryTenantAndReportsErrorsPerFile)
+{
+    constexpr int kTenants = 64;
+    auto schema            = MakeTenantSchema();
+
+    std::vector<std::unique_ptr<TenantConfig>> tenants;
+    std::vector<LoadJob<TenantParam>> jobs;
+    for (int t = 0; t < kTenants; ++t) {
+        tenants.push_back(std::make_unique<TenantConfig>(schema, TenantPath(t)));
+        jobs.push_back({tenants.back().get(), TenantPath(t)});
+
+        if (t == 5) {
+            continue;  // brak pliku
+        }
+        std::ofstream out(TenantPath(t));
+        if (t == 9) {
+            out << "port=not-a-number\n";  // odrzucona wartość
+            continue;
+        }
+        out << "host=tenant" << t << ".example\n";
+        // kilka dużych plików obok wielu małych
+        for (int line = 0; line < (t % 16 == 0 ? 20000 : 1); ++line) {
+            out << "port=" << 10000 + t << "\n";
+        }
+    }
+
+    WorkStealingPool pool(4);
+    std::vector<LoadResult> results = loadBatch(jobs, pool);
+
+    ASSERT_EQ(results.size(), jobs.size());
+    for (int t = 0; t < kTenants; ++t) {
+        EXPECT_EQ(results[t].path, TenantPath(t));
+        if (t == 5 || t == 9) {
+            ASSERT_FALSE(results[t].ok());
+            EXPECT_THROW(std::rethrow_exception(results[t].error), ConfigurationError);
+            // poprzednie wartości pozostają
+            EXPECT_EQ(tenants[t]->value<int>(TenantParam::Port), 0);
+            continue;
+        }
+        EXPECT_TRUE(results[t].ok());
+        EXPECT_EQ(tenants[t]->value<int>(TenantParam::Port), 10000 + t);
+        EXPECT_EQ(tenants[t]->value<std::string>(TenantParam::Host), "tenant" + std::to_string(t) + ".example");
+    }
+
+    for (int t = 0; t < kTenants; ++t) {
+        std::remove(TenantPath(t).c_str());
+    }
+}
@@ -0,0 +1,192 @@
+/*
+ * World VTT / cpp_config – tests wiązania konfiguracji ze strukturą
+ *
+ * Uruchamiać także pod ThreadSanitizerem: make test-tsan
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>  // std::remove
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ConfigBinding.h"
+#include "ConfigParameter.h"
+
+using namespace cpp_config;
+
+enum class NetParam
+{
+    Port,
+    Timeout,
+    NoDelay,
+    Host,
+    Count,
+};
+
+using NetConfig = Config<NetParam>;
+
+struct NetTuning
+{
+    int port;
+    double timeout;
+    bool nodelay;
+};
+
+static std::shared_ptr<const NetConfig::Schema> MakeNetSchema()
+{
+    return NetConfig::Schema::Builder()
+        .add(NetParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "80", ConfigValue::Type::Integer))
+        .add(NetParam::Timeout, std::make_shared<ConfigParameter>("timeout", "Timeout in seconds", "1.5", ConfigValue::Type::Floating))
+        .add(NetParam::NoDelay, std::make_shared<ConfigParameter>("nodelay", "TCP_NODELAY", "true", ConfigValue::Type::Bool))
+        .add(NetParam::Host, std::make_shared<ConfigParameter>("host", "Server host", "localhost"))
+        .build();
+}
+
+static void WriteNetFile(int port, bool nodelay)
+{
+    std::ofstream out("test_binding_config.cfg");
+    out << "port = " << port << "\n";
+    out << "nodelay = " << (nodelay ? "true" : "false") << "\n";
+}
+
+TEST(ConfigBindingTest, MaterializesStructAndFollowsReloads)
+{
+    NetConfig cfg(MakeNetSchema(), "test_binding_config.cfg");
+    ConfigBinding<NetParam, NetTuning> binding(cfg);
+    binding.bind(&NetTuning::port, NetParam::Port).bind(&NetTuning::timeout, NetParam::Timeout).bind(&NetTuning::nodelay, NetParam::NoDelay);
+
+    auto first = binding.snapshot();
+    EXPECT_EQ(first->value().port, 80);
+    EXPECT_DOUBLE_EQ(first->value().timeout, 1.5);
+    EXPECT_TRUE(first->value().nodelay);
+    EXPECT_EQ(first->generation(), cfg.generation());
+    // bez zmian konfiguracji ta sama kopia
+    EXPECT_EQ(binding.snapshot(), first);
+
+    // kopia powstaje już przy wczytaniu, nie przy pierwszym odczycie
+    WriteNetFile(9000, false);
+    cfg.loadFromFile();
+
+    auto second = binding.snapshot();
+    EXPECT_EQ(second->generation(), cfg.generation());
+    EXPECT_EQ(second->value().port, 9000);
+    EXPECT_FALSE(second->value().nodelay);
+    EXPECT_GT(second->generation(), first->generation());
+    // starsza kopia pozostaje niezmieniona
+    EXPECT_EQ(first->value().port, 80);
+
+    auto reader = binding.reader();
+    EXPECT_EQ(reader.get().port, 9000);
+    cfg.set(NetParam::Port, "9001");
+    EXPECT_EQ(reader.get().port, 9001);
+
+    std::remove("test_binding_config.cfg");
+}
+
+TEST(ConfigBindingTest, BindingChecksKeyAndType)
+{
+    NetConfig cfg(MakeNetSchema(), "test_binding_config.cfg");
+    ConfigBinding<NetParam, NetTuning> binding(cfg);
+    binding.bind(&NetTuning::port, NetParam::Port);
+
+    EXPECT_THROW(binding.bind(&NetTuning::port, NetParam::Count), std::out_of_range);
+    EXPECT_ANY_THROW(binding.bind(&NetTuning::port, NetParam::Host));
+
+    // nieudane wiązanie nie psuje wcześniejszych
+    cfg.set(NetParam::Port, "8080");
+    EXPECT_EQ(binding.snapshot()->value().port, 8080);
+}
+
+TEST(ConfigBindingTest, ValuesThatDoNotConvertAreRejectedBeforePublishing)
+{
+    NetConfig cfg(MakeNetSchema(), "test_binding_config.cfg");
+    {
+        ConfigBinding<NetParam, NetTuning> binding(cfg);
+        binding.bind(&NetTuning::port, NetParam::Port).bind(&NetTuning::nodelay, NetParam::NoDelay);
+        std::vector<std::string> hosts;
+        cfg.onChange(NetParam::Host, [&hosts](const ConfigParameter&, const ConfigParameter& current) { hosts.push_back(current.value()); });
+
+        // port mieści się w int64, ale nie w polu int – set() go odrzuca i
+        // niczego nie publikuje
+        const auto generation = cfg.generation();
+        EXPECT_THROW(cfg.set(NetParam::Port, "10000000000"), ConfigurationError);
+        EXPECT_EQ(cfg.value<int64_t>(NetParam::Port), 80);
+        EXPECT_EQ(cfg.generation(), generation);
+        EXPECT_EQ(binding.snapshot()->value().port, 80);
+
+        // ścisłe wczytanie odrzuca cały plik
+        {
+            std::ofstream out("test_binding_config.cfg");
+            out << "port = 10000000000\nnodelay = false\nhost = game.example\n";
+        }
+        EXPECT_THROW(cfg.loadFromFile(), ConfigurationError);
+        EXPECT_EQ(cfg.value<int64_t>(NetParam::Port), 80);
+        EXPECT_TRUE(binding.snapshot()->value().nodelay);
+        EXPECT_TRUE(hosts.empty());
+
+        // łagodne wczytanie zgłasza port i stosuje resztę, a kopia struktury
+        // i wywołania zwrotne pozostałych kluczy nadążają
+        LoadReport report = cfg.loadFromFile(LoadMode::Lenient);
+        ASSERT_EQ(report.issues().size(), 1u);
+        EXPECT_EQ(report.issues()[0].key, "port");
+        EXPECT_EQ(report.issues()[0].reason, LoadIssue::Reason::InvalidValue);
+        EXPECT_EQ(cfg.value<int64_t>(NetParam::Port), 80);
+        EXPECT_FALSE(binding.snapshot()->value().nodelay);
+        EXPECT_EQ(binding.snapshot()->generation(), cfg.generation());
+        EXPECT_EQ(hosts, std::vector<std::string>{"game.example"});
+
+        cfg.set(NetParam::Port, "8080");
+        EXPECT_EQ(binding.snapshot()->value().port, 8080);
+    }
+
+    // sprawdzenia zniszczonego wiązania niczego nie odrzucają
+    EXPECT_NO_THROW(cfg.set(NetParam::Port, "10000000000"));
+    EXPECT_EQ(cfg.value<int64_t>(NetParam::Port), 10000000000);
+    std::remove("test_binding_config.cfg");
+}
+
+TEST(ConfigBindingTest, ReadersSeeConsistentStructs)
+{
+    NetConfig cfg(MakeNetSchema(), "test_binding_config.cfg");
+    ConfigBinding<NetParam, NetTuning> binding(cfg);
+    binding.bind(&NetTuning::port, NetParam::Port).bind(&NetTuning::nodelay, NetParam::NoDelay);
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> sawFinal{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&]() {
+            auto reader = binding.reader();
+            int last    = 0;
+            while (!stop.load()) {
+                const NetTuning& tuning = reader.get();
+                // parzyste porty zawsze z nodelay – pola pochodzą z jednej migawki
+                EXPECT_EQ(tuning.nodelay, tuning.port % 2 == 0);
+                EXPECT_GE(tuning.port, last);
+                last = tuning.port;
+            }
+            if (reader.get().port == 10100) {
+                sawFinal.fetch_add(1);
+            }
+        });
+    }
+
+    for (int i = 1; i <= 100; ++i) {
+        WriteNetFile(10000 + i, i % 2 == 0);
+        cfg.loadFromFile();
+    }
+    stop.store(true);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(sawFinal.load(), 4);
+
+    std::remove("test_binding_config.cfg");
+}
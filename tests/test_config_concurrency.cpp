@@ -0,0 +1,171 @@
+/*
+ * World VTT / cpp_config – tests współbieżności
+ *
+ * Uruchamiać także pod ThreadSanitizerem: make test-tsan
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <barrier>
+#include <cstdio>  // std::remove
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Config.h"
+#include "ConfigParameter.h"
+
+using namespace cpp_config;
+
+enum class StressParam
+{
+    Generation,
+    Mirror,
+    Count,
+};
+
+using StressConfig = Config<StressParam>;
+
+namespace cpp_config {
+template<>
+const std::string Config<StressParam>::_confFileName = "test_stress_config.cfg";
+}  // namespace cpp_config
+
+static void WriteGeneration(int generation)
+{
+    std::ofstream out("test_stress_config.cfg");
+    out << "generation=" << generation << "\n";
+    out << "mirror=" << generation << "\n";
+}
+
+TEST(ConfigConcurrencyTest, ReadersSeeConsistentSnapshotsDuringReload)
+{
+    constexpr int kReaders = 8;
+    constexpr int kReloads = 200;
+
+    auto& cfg = StressConfig::instance();
+    cfg.clear();
+    cfg.addParam(StressParam::Generation, std::make_shared<ConfigParameter>("generation", "d", "0", ConfigValue::Type::Integer));
+    cfg.addParam(StressParam::Mirror, std::make_shared<ConfigParameter>("mirror", "d", "0", ConfigValue::Type::Integer));
+
+    const std::uint64_t initialGeneration = cfg.snapshot()->generation();
+
+    std::atomic<bool> done{false};
+    std::atomic<int> failures{0};
+    std::vector<std::thread> readers;
+
+    for (int r = 0; r < kReaders; ++r) {
+        readers.emplace_back([&cfg, &done, &failures]() {
+            int last = 0;
+            while (!done.load()) {
+                // Spójny widok: oba klucze pochodzą z tej samej generacji
+                auto snapshot = cfg.snapshot();
+                int generation = snapshot->value<int>(StressParam::Generation);
+                if (generation != snapshot->value<int>(StressParam::Mirror)) {
+                    failures.fetch_add(1);
+                }
+                // Generacja nigdy się nie cofa
+                if (generation < last) {
+                    failures.fetch_add(1);
+                }
+                last = generation;
+
+                int direct = cfg.value<int>(StressParam::Mirror);
+                if (direct < last) {
+                    failures.fetch_add(1);
+                }
+            }
+        });
+    }
+
+    for (int generation = 1; generation <= kReloads; ++generation) {
+        WriteGeneration(generation);
+        cfg.loadFromFile();
+    }
+    done.store(true);
+
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(cfg.value<int>(StressParam::Generation), kReloads);
+    EXPECT_EQ(cfg.snapshot()->generation(), initialGeneration + kReloads);
+
+    std::remove("test_stress_config.cfg");
+}
+
+TEST(ConfigConcurrencyTest, SnapshotOutlivesReload)
+{
+    auto& cfg = StressConfig::instance();
+    cfg.clear();
+    cfg.addParam(StressParam::Generation, std::make_shared<ConfigParameter>("generation", "d", "0"));
+
+    auto before = cfg.snapshot();
+    auto param  = cfg.get(StressParam::Generation);
+
+    WriteGeneration(7);
+    cfg.loadFromFile();
+
+    // Stary snapshot i parametr pozostają niezmienione
+    EXPECT_EQ(before->value<int>(StressParam::Generation), 0);
+    EXPECT_EQ(param->as<int>(), 0);
+    EXPECT_EQ(cfg.value<int>(StressParam::Generation), 7);
+    EXPECT_GT(cfg.snapshot()->generation(), before->generation());
+
+    std::remove("test_stress_config.cfg");
+}
+
+TEST(ConfigConcurrencyTest, ReplacedSnapshotsAreFreedUnderConstantReads)
+{
+    constexpr int kReaders = 8;
+    constexpr int kRounds  = 500;
+
+    StressConfig cfg(StressConfig::Schema::Builder()
+                         .add(StressParam::Generation, std::make_shared<ConfigParameter>("generation", "d", "0", ConfigValue::Type::Integer))
+                         .build(),
+                     "test_stress_config.cfg");
+
+    // czytelnicy i pisarz na zmianę: w każdej rundzie jedna publikacja, po
+    // niej odczyt w każdym wątku; żaden wątek nie przestaje czytać, a wynik
+    // nie zależy od szeregowania wątków
+    std::barrier sync(kReaders + 1);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < kReaders; ++r) {
+        readers.emplace_back([&cfg, &sync]() {
+            for (int round = 1; round <= kRounds; ++round) {
+                sync.arrive_and_wait();
+                EXPECT_EQ(cfg.value<int>(StressParam::Generation), round);
+                sync.arrive_and_wait();
+            }
+        });
+    }
+
+    std::vector<std::weak_ptr<const StressConfig::Snapshot>> replaced;
+    for (int round = 1; round <= kRounds; ++round) {
+        replaced.push_back(cfg.snapshot());
+        cfg.set(StressParam::Generation, std::to_string(round));
+        sync.arrive_and_wait();
+        sync.arrive_and_wait();
+        // publikacja w tej rundzie zwolniła partię z poprzedniej, a czytelnicy
+        // przeszli już na nową migawkę; pisarz trzyma tylko poprzednią
+        if (round >= 2) {
+            EXPECT_TRUE(replaced[round - 2].expired()) << "round " << round;
+        }
+    }
+    for (auto& reader : readers) {
+        reader.join();  // pamięć podręczna wątku znika wraz z nim
+    }
+
+    // pierwsza publikacja zamyka ostatnią partię, druga ją zwalnia
+    cfg.set(StressParam::Generation, "1");
+    cfg.set(StressParam::Generation, "2");
+    std::size_t alive = 0;
+    for (const auto& snapshot : replaced) {
+        alive += snapshot.expired() ? 0 : 1;
+    }
+    EXPECT_EQ(alive, 0u);
+}
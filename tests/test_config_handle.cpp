@@ -0,0 +1,114 @@
+/*
+ * World VTT / cpp_config – tests uchwytów ValueHandle
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdio>  // std::remove
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Config.h"
+#include "ConfigParameter.h"
+
+using namespace cpp_config;
+
+enum class HandleParam
+{
+    Port,
+    Host,
+    Count,
+};
+
+using HandleConfig = Config<HandleParam>;
+
+static std::shared_ptr<const HandleConfig::Schema> MakeHandleSchema()
+{
+    return HandleConfig::Schema::Builder()
+        .add(HandleParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "80", ConfigValue::Type::Integer))
+        .add(HandleParam::Host, std::make_shared<ConfigParameter>("host", "Server host", "localhost"))
+        .build();
+}
+
+static void WriteHandleFile(int port, const std::string& host)
+{
+    std::ofstream out("test_handle_config.cfg");
+    out << "port=" << port << "\n";
+    out << "host=" << host << "\n";
+}
+
+TEST(ValueHandleTest, ReadsCachedValueUntilConfigChanges)
+{
+    HandleConfig cfg(MakeHandleSchema(), "test_handle_config.cfg");
+    auto port = cfg.handle<int>(HandleParam::Port);
+    auto host = cfg.handle<std::string>(HandleParam::Host);
+
+    EXPECT_EQ(port.get(), 80);
+    EXPECT_EQ(host.get(), "localhost");
+    EXPECT_EQ(port.key(), HandleParam::Port);
+
+    // ten sam obiekt, dopóki konfiguracja się nie zmieni
+    const std::string* cached = &host.get();
+    EXPECT_EQ(&host.get(), cached);
+
+    WriteHandleFile(9000, "game.example");
+    const uint64_t before = cfg.generation();
+    cfg.loadFromFile();
+    EXPECT_GT(cfg.generation(), before);
+
+    EXPECT_EQ(port.get(), 9000);
+    EXPECT_EQ(host.get(), "game.example");
+
+    cfg.set(HandleParam::Port, "9001");
+    EXPECT_EQ(port.get(), 9001);
+
+    std::remove("test_handle_config.cfg");
+}
+
+TEST(ValueHandleTest, BindingChecksKeyAndType)
+{
+    HandleConfig cfg(MakeHandleSchema(), "test_handle_config.cfg");
+    EXPECT_THROW(cfg.handle<int>(HandleParam::Count), std::out_of_range);
+    EXPECT_ANY_THROW(cfg.handle<int>(HandleParam::Host));
+}
+
+TEST(ValueHandleTest, PerThreadCopiesObserveReloads)
+{
+    HandleConfig cfg(MakeHandleSchema(), "test_handle_config.cfg");
+    const auto prototype = cfg.handle<int>(HandleParam::Port);
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> sawFinal{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&, handle = prototype]() mutable {
+            int last = 0;
+            while (!stop.load()) {
+                int value = handle.get();
+                // wartości rosną z każdym przeładowaniem – uchwyt nie cofa się
+                EXPECT_GE(value, last);
+                last = value;
+            }
+            if (handle.get() == 10100) {
+                sawFinal.fetch_add(1);
+            }
+        });
+    }
+
+    for (int i = 1; i <= 100; ++i) {
+        WriteHandleFile(10000 + i, "host");
+        cfg.loadFromFile();
+    }
+    stop.store(true);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(sawFinal.load(), 4);
+
+    std::remove("test_handle_config.cfg");
+}
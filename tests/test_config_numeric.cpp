@@ -0,0 +1,161 @@
+/*
+ * World VTT / cpp_config – tests parametrów liczbowych z zakresem
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>  // std::remove
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "Config.h"
+#include "ConfigExceptions.h"
+#include "ConfigNumber.h"
+
+using namespace cpp_config;
+using namespace std::chrono_literals;
+
+TEST(ConfigNumberTest, IntegerChecksRangeAndStep)
+{
+    ConfigInteger port("port", "TCP port", "8080", 1, 65535);
+    EXPECT_EQ(port.number(), 8080);
+    EXPECT_EQ(port.as<int>(), 8080);
+    EXPECT_EQ(port.type(), ConfigValue::Type::Integer);
+    EXPECT_EQ(port.description(), "TCP port; [1, 65535]");
+
+    port.set("443");
+    EXPECT_EQ(port.number(), 443);
+    EXPECT_THROW(port.set("0"), ConfigurationError);
+    EXPECT_THROW(port.set("65536"), ConfigurationError);
+    // odrzucona wartość nie zmienia parametru
+    EXPECT_EQ(port.value(), "443");
+
+    ConfigInteger even("even", "Even number", "4", 0, 100, 2);
+    EXPECT_EQ(even.description(), "Even number; [0, 100], step 2");
+    EXPECT_NO_THROW(even.set("10"));
+    EXPECT_THROW(even.set("11"), ConfigurationError);
+
+    EXPECT_THROW(ConfigInteger("port", "TCP port", "0", 1, 65535), ConfigurationError);
+    EXPECT_THROW(ConfigInteger("port", "TCP port", "5", 10, 1), std::invalid_argument);
+}
+
+TEST(ConfigNumberTest, IntegerRejectsJunkAndOverflow)
+{
+    ConfigInteger count("count", "Count", "0");
+    EXPECT_EQ(count.description(), "Count");
+
+    // strtoll przyjąłby każdą z tych wartości
+    for (const char* text : {"12abc", " 12", "12 ", "", "+12", "0x10", "9223372036854775808", "1e3"}) {
+        EXPECT_THROW(count.set(text), ConfigurationError) << text;
+    }
+    count.set("-9223372036854775808");
+    EXPECT_EQ(count.number(), INT64_MIN);
+    // odczyt do za małego typu nie obcina wartości
+    EXPECT_THROW(count.as<int>(), std::out_of_range);
+}
+
+TEST(ConfigNumberTest, FloatChecksRangeAndStep)
+{
+    ConfigFloat ratio("ratio", "Ratio", "0.5", 0.0, 1.0, 0.1);
+    EXPECT_DOUBLE_EQ(ratio.number(), 0.5);
+    EXPECT_EQ(ratio.description(), "Ratio; [0, 1], step 0.1");
+
+    ratio.set("0.3");
+    EXPECT_DOUBLE_EQ(ratio.as<double>(), 0.3);
+    EXPECT_THROW(ratio.set("0.35"), ConfigurationError);
+    EXPECT_THROW(ratio.set("1.1"), ConfigurationError);
+    EXPECT_THROW(ratio.set("nan"), ConfigurationError);
+    EXPECT_THROW(ratio.set("0.5x"), ConfigurationError);
+    EXPECT_THROW(ratio.as<int>(), std::invalid_argument);
+}
+
+TEST(ConfigNumberTest, SizeParsesUnits)
+{
+    ConfigSize cache("cache", "Cache size", "64MiB", 1, 1ull << 40);
+    EXPECT_EQ(cache.number(), 64ull << 20);
+    EXPECT_EQ(cache.as<std::size_t>(), 64ull << 20);
+    EXPECT_EQ(cache.value(), "64MiB");
+    EXPECT_EQ(cache.description(), "Cache size; [1B, 1TiB]");
+
+    cache.set("2KB");
+    EXPECT_EQ(cache.number(), 2000u);
+    cache.set("512");
+    EXPECT_EQ(cache.number(), 512u);
+    cache.set("3GiB");
+    EXPECT_EQ(cache.number(), 3ull << 30);
+
+    for (const char* text : {"64 MiB", "64mib", "-1", "MiB", "1.5GiB", "2TiB", "99999999999TiB"}) {
+        EXPECT_THROW(cache.set(text), ConfigurationError) << text;
+    }
+}
+
+TEST(ConfigNumberTest, DurationParsesUnits)
+{
+    ConfigDuration timeout("timeout", "Timeout", "250ms", 1ms, 1h);
+    EXPECT_EQ(timeout.number(), 250ms);
+    EXPECT_EQ(timeout.as<std::chrono::milliseconds>(), 250ms);
+    EXPECT_EQ(timeout.as<std::chrono::seconds>(), 0s);
+    EXPECT_EQ(timeout.description(), "Timeout; [1ms, 1h]");
+
+    timeout.set("2min");
+    EXPECT_EQ(timeout.number(), 120s);
+    timeout.set("1500us");
+    EXPECT_EQ(timeout.number(), 1500us);
+
+    for (const char* text : {"250", "250 ms", "1d", "2h", "500ns", "ms"}) {
+        EXPECT_THROW(timeout.set(text), ConfigurationError) << text;
+    }
+    // czas nie jest zwykłą liczbą
+    EXPECT_THROW(timeout.as<int>(), std::invalid_argument);
+}
+
+TEST(ConfigNumberTest, CopiesKeepBounds)
+{
+    ConfigInteger level("level", "Level", "3", 0, 9);
+    auto copy = level.clone();
+    EXPECT_THROW(copy->set("10"), ConfigurationError);
+    copy->set("7");
+    EXPECT_EQ(copy->as<int>(), 7);
+    EXPECT_EQ(level.number(), 3);
+
+    ConfigInteger moved(std::move(level));
+    EXPECT_EQ(moved.max(), 9);
+    EXPECT_THROW(moved.set("10"), ConfigurationError);
+}
+
+enum class NumericParam
+{
+    Port,
+    Cache,
+    Timeout,
+};
+
+TEST(ConfigNumberTest, ConfigReadsNativeValues)
+{
+    using NumericConfig = Config<NumericParam>;
+    auto schema         = NumericConfig::Schema::Builder()
+                      .add(NumericParam::Port, std::make_shared<ConfigInteger>("port", "TCP port", "80", 1, 65535))
+                      .add(NumericParam::Cache, std::make_shared<ConfigSize>("cache", "Cache size", "64MiB"))
+                      .add(NumericParam::Timeout, std::make_shared<ConfigDuration>("timeout", "Timeout", "250ms"))
+                      .build();
+    NumericConfig cfg(schema, "test_numeric_config.cfg");
+    {
+        std::ofstream out("test_numeric_config.cfg");
+        out << "port = 9000\ncache = 1GiB\ntimeout = 2s\n";
+    }
+    cfg.loadFromFile();
+
+    EXPECT_EQ(cfg.value<int>(NumericParam::Port), 9000);
+    EXPECT_EQ(cfg.value<std::uint64_t>(NumericParam::Cache), 1ull << 30);
+    EXPECT_EQ(cfg.value<std::chrono::milliseconds>(NumericParam::Timeout), 2000ms);
+    EXPECT_EQ(cfg.get(NumericParam::Cache)->value(), "1GiB");
+
+    EXPECT_THROW(cfg.set(NumericParam::Port, "70000"), ConfigurationError);
+    EXPECT_EQ(cfg.value<int>(NumericParam::Port), 9000);
+
+    std::remove("test_numeric_config.cfg");
+}
@@ -0,0 +1,206 @@
+/*
+ * World VTT / cpp_config – tests tokenizera plików konfiguracyjnych
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>  // std::remove
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Config.h"
+#include "ConfigParameter.h"
+#include "ConfigParser.h"
+
+using namespace cpp_config;
+
+using Entries = std::vector<std::pair<std::string, std::string>>;
+
+static Entries Tokenize(std::string_view text)
+{
+    Entries entries;
+    parseKeyValues(text, [&entries](std::string_view name, std::string_view value) {
+        entries.emplace_back(name, value);
+    });
+    return entries;
+}
+
+// Ten sam tekst podany w kawałkach po `chunk` bajtów
+static Entries TokenizeChunks(std::string_view text, std::size_t chunk)
+{
+    Entries entries;
+    auto collect = [&entries](std::string_view name, std::string_view value) {
+        entries.emplace_back(name, value);
+    };
+    IniTokenizer tokenizer;
+    for (std::size_t pos = 0; pos < text.size(); pos += chunk) {
+        tokenizer.feed(text.substr(pos, chunk), collect);
+    }
+    tokenizer.finish(collect);
+    return entries;
+}
+
+static const std::string kSample =
+    "# komentarz\n"
+    "; też komentarz\n"
+    "verbose = true\n"
+    "\n"
+    "[server]\n"
+    "  port   =  8080   # numer portu\n"
+    "host = \"example.org\"  ; komentarz po cudzysłowie\n"
+    "banner = \"Witaj \\\"świecie\\\"\\n\"\n"
+    "path = 'C:\\dane\\mapy'\n"
+    "\n"
+    "[ database . pool ]\n"
+    "size=4\r\n"
+    "\"max.idle\" = 10\n"
+    "color=#ff0000\n"
+    "last=bez nowej linii";
+
+TEST(IniTokenizerTest, SectionsQuotesCommentsAndTrimming)
+{
+    Entries expected{
+        {"verbose", "true"},
+        {"server.port", "8080"},
+        {"server.host", "example.org"},
+        {"server.banner", "Witaj \"świecie\"\n"},
+        {"server.path", "C:\\dane\\mapy"},
+        {"database.pool.size", "4"},
+        {"database.pool.max.idle", "10"},
+        {"database.pool.color", "#ff0000"},
+        {"database.pool.last", "bez nowej linii"},
+    };
+    EXPECT_EQ(Tokenize(kSample), expected);
+}
+
+TEST(IniTokenizerTest, ChunkBoundariesDoNotChangeTheResult)
+{
+    const Entries whole = Tokenize(kSample);
+    for (std::size_t chunk : {1, 2, 3, 7, 16, 64}) {
+        EXPECT_EQ(TokenizeChunks(kSample, chunk), whole) << "chunk = " << chunk;
+    }
+}
+
+TEST(IniTokenizerTest, DottedKeysAtTopLevelMatchSections)
+{
+    Entries expected{{"server.port", "1"}, {"server.port", "2"}, {"server.port", "3"}};
+    EXPECT_EQ(Tokenize("server.port=1\nserver . port = 2\n[server]\nport=3\n"), expected);
+}
+
+TEST(IniTokenizerTest, MalformedLinesAreSkipped)
+{
+    IniTokenizer tokenizer;
+    EXPECT_EQ(tokenizer.parse("bez_znaku_rownosci"), IniTokenizer::Line::Malformed);
+    EXPECT_EQ(tokenizer.parse("=wartosc"), IniTokenizer::Line::Malformed);
+    EXPECT_EQ(tokenizer.parse("a..b=1"), IniTokenizer::Line::Malformed);
+    EXPECT_EQ(tokenizer.parse("a=\"niezamknięty"), IniTokenizer::Line::Malformed);
+    EXPECT_EQ(tokenizer.parse("a=\"x\" śmieci"), IniTokenizer::Line::Malformed);
+    EXPECT_EQ(tokenizer.parse("a=\"\\q\""), IniTokenizer::Line::Malformed);
+    EXPECT_EQ(tokenizer.parse("   "), IniTokenizer::Line::Blank);
+
+    EXPECT_EQ(tokenizer.parse("a = b=c"), IniTokenizer::Line::Entry);
+    EXPECT_EQ(tokenizer.name(), "a");
+    EXPECT_EQ(tokenizer.value(), "b=c");
+    EXPECT_EQ(tokenizer.parse("a ="), IniTokenizer::Line::Entry);
+    EXPECT_EQ(tokenizer.value(), "");
+
+    // po błędnym nagłówku wpisy są pomijane aż do następnej sekcji
+    EXPECT_EQ(tokenizer.parse("[sekcja"), IniTokenizer::Line::Malformed);
+    EXPECT_EQ(tokenizer.parse("a=1"), IniTokenizer::Line::Malformed);
+    EXPECT_STREQ(tokenizer.error(), "entry under an invalid section header");
+    EXPECT_EQ(tokenizer.parse("[sekcja]"), IniTokenizer::Line::Section);
+    EXPECT_EQ(tokenizer.parse("a=1"), IniTokenizer::Line::Entry);
+    EXPECT_EQ(tokenizer.name(), "sekcja.a");
+}
+
+TEST(IniTokenizerTest, MalformedLinesReportColumnAndReason)
+{
+    struct Case
+    {
+        const char* line;
+        size_t column;
+        std::string error;
+    };
+    const Case cases[] = {
+        {"  bez_znaku", 3, "expected `key = value`"},
+        {"  = 1", 3, "empty key"},
+        {"a..b = 1", 1, "invalid key"},
+        {"a = \"otwarty", 5, "unterminated string"},
+        {"a = \"x\\q\"", 7, "invalid escape sequence"},
+        {"a = 'x'  y", 10, "unexpected text after string"},
+        {"[sekcja] x", 10, "unexpected text after section header"},
+        {" [sekcja", 2, "unterminated section header"},
+    };
+    for (const auto& c : cases) {
+        IniTokenizer tokenizer;
+        EXPECT_EQ(tokenizer.parse(c.line), IniTokenizer::Line::Malformed) << c.line;
+        EXPECT_EQ(tokenizer.column(), c.column) << c.line;
+        EXPECT_EQ(tokenizer.error(), c.error) << c.line;
+    }
+
+    IniTokenizer tokenizer;
+    ASSERT_EQ(tokenizer.parse("  port =  80"), IniTokenizer::Line::Entry);
+    EXPECT_EQ(tokenizer.column(), 3u);
+    EXPECT_EQ(tokenizer.valueColumn(), 11u);
+}
+
+TEST(IniTokenizerTest, EntriesUnderMalformedSectionAreSkipped)
+{
+    Entries expected{{"a", "1"}, {"ok.c", "3"}};
+    EXPECT_EQ(Tokenize("a=1\n[[tablica]]\nb=2\n[ok]\nc=3\n"), expected);
+}
+
+TEST(IniTokenizerTest, AppendValueRoundTrips)
+{
+    for (std::string value : {"", "zwykła wartość", " spacja", "tab\t", "\"cudzysłów", "'apostrof", "a # nie komentarz",
+                              "x ;y", "linia\nkolejna", "ukośnik\\", "#ff0000"}) {
+        std::string line = "k=";
+        appendValue(line, value);
+        Entries expected{{"k", value}};
+        EXPECT_EQ(Tokenize(line), expected) << line;
+    }
+}
+
+enum class IniParam
+{
+    Port,
+    Host,
+    Motd,
+};
+
+using IniConfig = Config<IniParam>;
+
+TEST(IniConfigTest, SectionedNamesMapOntoRegisteredParameters)
+{
+    auto schema = IniConfig::Schema::Builder()
+                      .add(IniParam::Port, std::make_shared<ConfigParameter>("server.port", "TCP port", "80", ConfigValue::Type::Integer))
+                      .add(IniParam::Host, std::make_shared<ConfigParameter>("server.host", "Server host", "localhost"))
+                      .add(IniParam::Motd, std::make_shared<ConfigParameter>("motd", "Message of the day", ""))
+                      .build();
+    IniConfig cfg(schema, "test_ini_config.cfg");
+
+    {
+        std::ofstream out("test_ini_config.cfg");
+        out << "motd = \"  witaj # gościu  \"\n";
+        out << "[server]\n";
+        out << "port = 9000  # port nasłuchu\n";
+        out << "host = 'game.example'\n";
+    }
+    cfg.loadFromFile();
+
+    EXPECT_EQ(cfg.value<int>(IniParam::Port), 9000);
+    EXPECT_EQ(cfg.value<std::string>(IniParam::Host), "game.example");
+    EXPECT_EQ(cfg.value<std::string>(IniParam::Motd), "  witaj # gościu  ");
+
+    // zapis i ponowny odczyt zachowują wartość wymagającą cudzysłowów
+    cfg.saveToFile();
+    IniConfig reloaded(schema, "test_ini_config.cfg");
+    reloaded.loadFromFile();
+    EXPECT_EQ(reloaded.value<std::string>(IniParam::Motd), "  witaj # gościu  ");
+    EXPECT_EQ(reloaded.value<int>(IniParam::Port), 9000);
+
+    std::remove("test_ini_config.cfg");
+}
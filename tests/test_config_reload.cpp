@@ -0,0 +1,276 @@
+/*
+ * World VTT / cpp_config – tests przyrostowego i asynchronicznego przeładowania
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstdio>  // std::remove
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Config.h"
+#include "ConfigChoice.h"
+#include "ConfigParameter.h"
+
+using namespace cpp_config;
+
+enum class ReloadParam
+{
+    Port,
+    Host,
+    Mode,
+    Count,
+};
+
+using ReloadConfig = Config<ReloadParam>;
+
+static const char* ReloadFile = "test_reload_config.cfg";
+
+static std::shared_ptr<const ReloadConfig::Schema> MakeReloadSchema()
+{
+    return ReloadConfig::Schema::Builder()
+        .add(ReloadParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "80", ConfigValue::Type::Integer))
+        .add(ReloadParam::Host, std::make_shared<ConfigParameter>("host", "Server host", "localhost"))
+        .add(ReloadParam::Mode, std::make_shared<ConfigChoice>("mode", "Mode", "auto", std::vector<std::string>{"auto", "manual"}))
+        .build();
+}
+
+static void WriteReloadFile(const std::string& content)
+{
+    std::ofstream out(ReloadFile);
+    out << content;
+}
+
+// Cofa czas modyfikacji, żeby rozmiar i mtime pliku były wiarygodne
+static void AgeReloadFile(std::filesystem::file_time_type time)
+{
+    std::filesystem::last_write_time(ReloadFile, time);
+}
+
+TEST(ConfigReloadTest, AppliesOnlyChangedKeys)
+{
+    ReloadConfig cfg(MakeReloadSchema(), ReloadFile);
+    WriteReloadFile("port = 9000\nhost = game.example\nmode = auto\n");
+
+    auto first = cfg.reload();
+    EXPECT_FALSE(first.skipped);
+    EXPECT_EQ(first.changed, (std::vector<ReloadParam>{ReloadParam::Port, ReloadParam::Host}));
+    EXPECT_EQ(cfg.value<int>(ReloadParam::Port), 9000);
+
+    auto host = cfg.get(ReloadParam::Host);
+    std::vector<std::string> seen;
+    cfg.onChange(ReloadParam::Port, [&seen](const ConfigParameter&, const ConfigParameter& current) { seen.push_back(current.value()); });
+    cfg.onChange(ReloadParam::Host, [&seen](const ConfigParameter&, const ConfigParameter& current) { seen.push_back(current.value()); });
+
+    WriteReloadFile("port = 9001\nhost = game.example\nmode = auto\n");
+    auto second = cfg.reload();
+    EXPECT_FALSE(second.skipped);
+    EXPECT_EQ(second.changed, std::vector<ReloadParam>{ReloadParam::Port});
+    EXPECT_EQ(cfg.value<int>(ReloadParam::Port), 9001);
+    // niezmieniony parametr to nadal ten sam obiekt
+    EXPECT_EQ(cfg.get(ReloadParam::Host), host);
+    EXPECT_EQ(seen, std::vector<std::string>{"9001"});
+
+    std::remove(ReloadFile);
+}
+
+TEST(ConfigReloadTest, SkipsUnchangedFile)
+{
+    ReloadConfig cfg(MakeReloadSchema(), ReloadFile);
+    WriteReloadFile("port = 9000\n");
+    cfg.reload();
+    const uint64_t generation = cfg.generation();
+
+    // ta sama treść, nowy czas modyfikacji – rozstrzyga skrót treści
+    WriteReloadFile("port = 9000\n");
+    auto touched = cfg.reload();
+    EXPECT_TRUE(touched.skipped);
+    EXPECT_TRUE(touched.changed.empty());
+    EXPECT_EQ(cfg.generation(), generation);
+
+    // stary plik – wystarczają rozmiar i czas modyfikacji; podmieniona treść
+    // o tym samym rozmiarze i czasie dowodzi, że pliku nie czytano
+    const auto old = std::filesystem::file_time_type::clock::now() - std::chrono::seconds(10);
+    AgeReloadFile(old);
+    cfg.reload();
+    WriteReloadFile("port = 9001\n");
+    AgeReloadFile(old);
+    auto stamped = cfg.reload();
+    EXPECT_TRUE(stamped.skipped);
+    EXPECT_EQ(cfg.value<int>(ReloadParam::Port), 9000);
+    EXPECT_EQ(cfg.generation(), generation);
+
+    // zmieniony komentarz: plik przeczytany, ale nic nie opublikowano
+    WriteReloadFile("# port\nport = 9000\n");
+    auto comment = cfg.reload();
+    EXPECT_FALSE(comment.skipped);
+    EXPECT_TRUE(comment.changed.empty());
+    EXPECT_EQ(cfg.generation(), generation);
+
+    std::remove(ReloadFile);
+}
+
+TEST(ConfigReloadTest, MatchesFullLoad)
+{
+    ReloadConfig cfg(MakeReloadSchema(), ReloadFile);
+    WriteReloadFile("port = 9000\nmode = manual\n");
+    cfg.reload();
+
+    // późniejszy duplikat przywraca poprzednią wartość
+    WriteReloadFile("port = 1\nmode = manual\nport = 9000\n");
+    EXPECT_TRUE(cfg.reload().changed.empty());
+    EXPECT_EQ(cfg.value<int>(ReloadParam::Port), 9000);
+
+    // zmiana w trakcie działania – kolejne przeładowanie stosuje cały plik
+    cfg.set(ReloadParam::Port, "1234");
+    EXPECT_EQ(cfg.reload().changed, std::vector<ReloadParam>{ReloadParam::Port});
+    EXPECT_EQ(cfg.value<int>(ReloadParam::Port), 9000);
+    EXPECT_EQ(cfg.source(ReloadParam::Port).kind, ValueSource::Kind::File);
+
+    std::remove(ReloadFile);
+}
+
+TEST(ConfigReloadTest, RejectedValueIsRetried)
+{
+    ReloadConfig cfg(MakeReloadSchema(), ReloadFile);
+    WriteReloadFile("port = 9000\nmode = auto\n");
+    cfg.reload();
+
+    WriteReloadFile("port = 9001\nmode = sometimes\n");
+    EXPECT_THROW(cfg.reload(), ConfigurationError);
+    EXPECT_EQ(cfg.value<int>(ReloadParam::Port), 9000);
+    // ten sam plik jest odrzucany ponownie, a nie pomijany
+    EXPECT_THROW(cfg.reload(), ConfigurationError);
+
+    WriteReloadFile("port = 9001\nmode = manual\n");
+    auto fixed = cfg.reload();
+    EXPECT_EQ(fixed.changed, (std::vector<ReloadParam>{ReloadParam::Port, ReloadParam::Mode}));
+    EXPECT_EQ(cfg.value<std::string>(ReloadParam::Mode), "manual");
+
+    std::remove(ReloadFile);
+}
+
+TEST(ConfigReloadTest, CreatesMissingFile)
+{
+    std::remove(ReloadFile);
+    ReloadConfig cfg(MakeReloadSchema(), ReloadFile);
+    auto result = cfg.reload();
+    EXPECT_TRUE(result.changed.empty());
+    EXPECT_TRUE(std::filesystem::exists(ReloadFile));
+
+    std::remove(ReloadFile);
+}
+
+TEST(ConfigReloadTest, ReloadAsyncAppliesInBackground)
+{
+    ReloadConfig cfg(MakeReloadSchema(), ReloadFile);
+    WriteReloadFile("port = 9000\nhost = game.example\n");
+
+    std::atomic<bool> otherThread{false};
+    const std::thread::id caller = std::this_thread::get_id();
+    cfg.onChange(ReloadParam::Port, [&](const ConfigParameter&, const ConfigParameter&) { otherThread = std::this_thread::get_id() != caller; });
+
+    auto result = cfg.reloadAsync().get();
+    EXPECT_FALSE(result.cancelled);
+    EXPECT_EQ(result.changed, (std::vector<ReloadParam>{ReloadParam::Port, ReloadParam::Host}));
+    EXPECT_EQ(cfg.value<int>(ReloadParam::Port), 9000);
+    EXPECT_TRUE(otherThread.load());
+
+    // kolejne żądanie korzysta ze stanu przyrostowego
+    WriteReloadFile("port = 9001\nhost = game.example\n");
+    EXPECT_EQ(cfg.reloadAsync().get().changed, std::vector<ReloadParam>{ReloadParam::Port});
+
+    // odrzucona wartość trafia do future, konfiguracja bez zmian
+    WriteReloadFile("port = 9002\nmode = sometimes\n");
+    EXPECT_THROW(cfg.reloadAsync().get(), ConfigurationError);
+    EXPECT_EQ(cfg.value<int>(ReloadParam::Port), 9001);
+
+    std::remove(ReloadFile);
+}
+
+TEST(ConfigReloadTest, NewerReloadAsyncSupersedesOlder)
+{
+    ReloadConfig cfg(MakeReloadSchema(), ReloadFile);
+    WriteReloadFile("port = 1\n");
+
+    // pierwsze przeładowanie blokuje wątek tła w callbacku
+    std::atomic<bool> entered{false};
+    std::atomic<bool> release{false};
+    cfg.onChange(ReloadParam::Port, [&](const ConfigParameter&, const ConfigParameter&) {
+        entered = true;
+        while (!release.load()) {
+            std::this_thread::yield();
+        }
+    });
+    auto first = cfg.reloadAsync();
+    while (!entered.load()) {
+        std::this_thread::yield();
+    }
+
+    WriteReloadFile("port = 2\n");
+    auto second = cfg.reloadAsync();
+    WriteReloadFile("port = 3\n");
+    auto third = cfg.reloadAsync();
+    release = true;
+
+    EXPECT_EQ(first.get().changed, std::vector<ReloadParam>{ReloadParam::Port});
+    auto skipped = second.get();
+    EXPECT_TRUE(skipped.cancelled);
+    EXPECT_TRUE(skipped.changed.empty());
+    auto latest = third.get();
+    EXPECT_FALSE(latest.cancelled);
+    EXPECT_EQ(cfg.value<int>(ReloadParam::Port), 3);
+
+    std::remove(ReloadFile);
+}
+
+// Minimalna korutyna bez zawieszania na starcie i końcu
+struct ReloadTask
+{
+    struct promise_type
+    {
+        ReloadTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+static ReloadTask AwaitReload(ReloadConfig& cfg, std::promise<ReloadConfig::ReloadResult>& out)
+{
+    try {
+        out.set_value(co_await cfg.awaitReload());
+    } catch (...) {
+        out.set_exception(std::current_exception());
+    }
+}
+
+TEST(ConfigReloadTest, AwaitReloadResumesWithResult)
+{
+    ReloadConfig cfg(MakeReloadSchema(), ReloadFile);
+    WriteReloadFile("host = awaited.example\n");
+
+    std::promise<ReloadConfig::ReloadResult> done;
+    auto future = done.get_future();
+    AwaitReload(cfg, done);
+    EXPECT_EQ(future.get().changed, std::vector<ReloadParam>{ReloadParam::Host});
+    EXPECT_EQ(cfg.value<std::string>(ReloadParam::Host), "awaited.example");
+
+    WriteReloadFile("port = none\n");
+    std::promise<ReloadConfig::ReloadResult> failed;
+    auto error = failed.get_future();
+    AwaitReload(cfg, failed);
+    EXPECT_THROW(error.get(), ConfigurationError);
+
+    std::remove(ReloadFile);
+}
@@ -0,0 +1,174 @@
+/*
+ * World VTT / cpp_config – tests raportu z wczytywania pliku
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>  // std::remove
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Config.h"
+#include "ConfigChoice.h"
+#include "ConfigParameter.h"
+#include "ConfigReport.h"
+
+using namespace cpp_config;
+
+enum class ReportParam
+{
+    Port,
+    Mode,
+    Host,
+};
+
+using ReportConfig = Config<ReportParam>;
+
+static std::shared_ptr<const ReportConfig::Schema> MakeReportSchema()
+{
+    return ReportConfig::Schema::Builder()
+        .add(ReportParam::Port, std::make_shared<ConfigParameter>("server.port", "TCP port", "80", ConfigValue::Type::Integer))
+        .add(ReportParam::Mode, std::make_shared<ConfigChoice>("mode", "Mode", "auto", std::vector<std::string>{"auto", "manual"}))
+        .add(ReportParam::Host, std::make_shared<ConfigParameter>("server.host", "Server host", "localhost"))
+        .build();
+}
+
+// Plik z jednym błędem każdego rodzaju i jedną poprawną wartością
+static void WriteBrokenFile()
+{
+    std::ofstream out("test_report_config.cfg");
+    out << "mode = sometimes\n";        // 1: wartość spoza listy
+    out << "[server]\n";                // 2
+    out << "host = game.example\n";     // 3: poprawna
+    out << "prot = 9000\n";             // 4: literówka – nieznany klucz
+    out << "port = \"9000\n";           // 5: niezamknięty napis
+    out << "port = abc\n";              // 6: to nie liczba
+}
+
+TEST(LoadReportTest, LenientLoadAppliesValidValuesAndReportsTheRest)
+{
+    ReportConfig cfg(MakeReportSchema(), "test_report_config.cfg");
+    WriteBrokenFile();
+
+    LoadReport report = cfg.loadFromFile(LoadMode::Lenient);
+
+    EXPECT_EQ(cfg.value<std::string>(ReportParam::Host), "game.example");
+    EXPECT_EQ(cfg.value<int>(ReportParam::Port), 80);
+    EXPECT_EQ(cfg.value<std::string>(ReportParam::Mode), "auto");
+    // odrzucona wartość nie zmienia źródła parametru
+    EXPECT_EQ(cfg.source(ReportParam::Port).kind, ValueSource::Kind::Default);
+    EXPECT_EQ(cfg.source(ReportParam::Host).kind, ValueSource::Kind::File);
+
+    ASSERT_EQ(report.issues().size(), 4u);
+    EXPECT_EQ(report.errors(), 3u);
+    EXPECT_FALSE(report.ok());
+
+    const auto& unknown = report.issues()[0];
+    EXPECT_EQ(unknown.reason, LoadIssue::Reason::UnknownKey);
+    EXPECT_EQ(unknown.key, "server.prot");
+    EXPECT_EQ(unknown.line, 4u);
+    EXPECT_EQ(unknown.column, 1u);
+    EXPECT_FALSE(unknown.error());
+
+    const auto& malformed = report.issues()[1];
+    EXPECT_EQ(malformed.reason, LoadIssue::Reason::Malformed);
+    EXPECT_EQ(malformed.line, 5u);
+    EXPECT_EQ(malformed.column, 8u);
+    EXPECT_EQ(malformed.message, "unterminated string");
+
+    // wartości sprawdzane są po przeczytaniu całego pliku, w kolejności kluczy
+    const auto& port = report.issues()[2];
+    EXPECT_EQ(port.reason, LoadIssue::Reason::InvalidValue);
+    EXPECT_EQ(port.key, "server.port");
+    EXPECT_EQ(port.line, 6u);
+    EXPECT_EQ(port.column, 8u);
+    EXPECT_EQ(port.source, "test_report_config.cfg");
+
+    const auto& mode = report.issues()[3];
+    EXPECT_EQ(mode.key, "mode");
+    EXPECT_EQ(mode.line, 1u);
+    EXPECT_EQ(mode.column, 8u);
+
+    EXPECT_NE(report.toString().find("test_report_config.cfg:4:1: unknown key `server.prot`"), std::string::npos);
+
+    std::remove("test_report_config.cfg");
+}
+
+TEST(LoadReportTest, StrictLoadPublishesNothingOnError)
+{
+    ReportConfig cfg(MakeReportSchema(), "test_report_config.cfg");
+    WriteBrokenFile();
+    auto before = cfg.snapshot();
+
+    try {
+        cfg.loadFromFile(LoadMode::Strict);
+        FAIL() << "oczekiwano ConfigLoadError";
+    } catch (const ConfigLoadError& e) {
+        EXPECT_EQ(e.report().errors(), 3u);
+        EXPECT_EQ(e.report().issues().size(), 4u);
+    }
+
+    // poprawny `host` też nie został zastosowany
+    EXPECT_EQ(cfg.snapshot(), before);
+    EXPECT_EQ(cfg.value<std::string>(ReportParam::Host), "localhost");
+
+    std::remove("test_report_config.cfg");
+}
+
+TEST(LoadReportTest, StrictLoadCommitsWithOnlyUnknownKeys)
+{
+    ReportConfig cfg(MakeReportSchema(), "test_report_config.cfg");
+    {
+        std::ofstream out("test_report_config.cfg");
+        out << "[server]\nport = 9000\nlegacy = 1\n";
+    }
+
+    LoadReport report = cfg.loadFromFile("test_report_config.cfg", LoadMode::Strict);
+
+    EXPECT_TRUE(report.ok());
+    ASSERT_EQ(report.issues().size(), 1u);
+    EXPECT_EQ(report.issues()[0].key, "server.legacy");
+    EXPECT_EQ(cfg.value<int>(ReportParam::Port), 9000);
+
+    std::remove("test_report_config.cfg");
+}
+
+TEST(LoadReportTest, ReportsEarlierValuesOfDuplicatedKeys)
+{
+    ReportConfig cfg(MakeReportSchema(), "test_report_config.cfg");
+    {
+        std::ofstream out("test_report_config.cfg");
+        out << "[server]\n"
+               "port = abc\n"     // 2: błędna, ale nadpisana
+               "port = 9000\n";   // 3: obowiązuje
+    }
+
+    LoadReport report = cfg.loadFromFile(LoadMode::Strict);
+
+    EXPECT_TRUE(report.ok());
+    EXPECT_EQ(cfg.value<int>(ReportParam::Port), 9000);
+    ASSERT_EQ(report.issues().size(), 1u);
+    const auto& duplicate = report.issues()[0];
+    EXPECT_EQ(duplicate.reason, LoadIssue::Reason::DuplicateKey);
+    EXPECT_EQ(duplicate.key, "server.port");
+    EXPECT_EQ(duplicate.line, 2u);
+    EXPECT_EQ(duplicate.column, 8u);
+    EXPECT_FALSE(duplicate.error());
+    EXPECT_NE(duplicate.message.find("`abc`"), std::string::npos);
+    EXPECT_NE(report.toString().find("test_report_config.cfg:2:8: duplicate key `server.port`"), std::string::npos);
+
+    std::remove("test_report_config.cfg");
+}
+
+TEST(LoadReportTest, PlainLoadStillThrowsOnFirstRejectedValue)
+{
+    ReportConfig cfg(MakeReportSchema(), "test_report_config.cfg");
+    WriteBrokenFile();
+
+    EXPECT_THROW(cfg.loadFromFile(), ConfigurationError);
+    EXPECT_EQ(cfg.value<std::string>(ReportParam::Host), "localhost");
+
+    std::remove("test_report_config.cfg");
+}
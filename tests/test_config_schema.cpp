@@ -0,0 +1,139 @@
+/*
+ * World VTT / cpp_config – tests schematu czasu kompilacji (StaticConfig)
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>  // std::remove
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "ConfigExceptions.h"
+#include "ConfigSchema.h"
+
+using namespace cpp_config;
+
+enum class StaticParam
+{
+    Port,
+    Host,
+    Ratio,
+    Verbose,
+};
+
+template <>
+struct cpp_config::ParamTraits<StaticParam::Port> {
+        using type = int;
+        static constexpr std::string_view name        = "port";
+        static constexpr std::string_view description = "TCP port";
+        static constexpr int defaultValue             = 8080;
+};
+
+template <>
+struct cpp_config::ParamTraits<StaticParam::Host> {
+        using type = std::string;
+        static constexpr std::string_view name         = "host";
+        static constexpr std::string_view description  = "Server host";
+        static constexpr std::string_view defaultValue = "localhost";
+};
+
+template <>
+struct cpp_config::ParamTraits<StaticParam::Ratio> {
+        using type = double;
+        static constexpr std::string_view name        = "ratio";
+        static constexpr std::string_view description = "Ratio";
+        static constexpr double defaultValue          = 0.5;
+};
+
+template <>
+struct cpp_config::ParamTraits<StaticParam::Verbose> {
+        using type = bool;
+        static constexpr std::string_view name        = "verbose";
+        static constexpr std::string_view description = "Verbose logging";
+        static constexpr bool defaultValue            = false;
+};
+
+using TestStaticConfig = StaticConfig<StaticParam, StaticParam::Port, StaticParam::Host, StaticParam::Ratio, StaticParam::Verbose>;
+
+// Typ zwracany przez get<Key>() wynika ze schematu
+static_assert(std::is_same_v<decltype(std::declval<TestStaticConfig>().get<StaticParam::Port>()), int>);
+static_assert(std::is_same_v<decltype(std::declval<TestStaticConfig>().get<StaticParam::Host>()), std::string>);
+static_assert(TestStaticConfig::name<StaticParam::Ratio>() == "ratio");
+
+TEST(StaticConfigTest, DefaultsWithoutParsing)
+{
+    TestStaticConfig cfg("test_static_config.cfg");
+
+    EXPECT_EQ(cfg.get<StaticParam::Port>(), 8080);
+    EXPECT_EQ(cfg.get<StaticParam::Host>(), "localhost");
+    EXPECT_DOUBLE_EQ(cfg.get<StaticParam::Ratio>(), 0.5);
+    EXPECT_FALSE(cfg.get<StaticParam::Verbose>());
+}
+
+TEST(StaticConfigTest, LoadFromFile)
+{
+    {
+        std::ofstream out("test_static_config.cfg");
+        out << "# komentarz\n";
+        out << "port=9000\n";
+        out << "host=example.org\n";
+        out << "verbose=true\n";
+        out << "unknown=1\n";
+    }
+
+    TestStaticConfig cfg("test_static_config.cfg");
+    cfg.loadFromFile();
+
+    auto snapshot = cfg.snapshot();
+    EXPECT_EQ(snapshot->get<StaticParam::Port>(), 9000);
+    EXPECT_EQ(snapshot->get<StaticParam::Host>(), "example.org");
+    EXPECT_DOUBLE_EQ(snapshot->get<StaticParam::Ratio>(), 0.5);
+    EXPECT_TRUE(snapshot->get<StaticParam::Verbose>());
+    EXPECT_EQ(snapshot->generation(), 1u);
+
+    std::remove("test_static_config.cfg");
+}
+
+TEST(StaticConfigTest, InvalidValueRejectsWholeLoad)
+{
+    {
+        std::ofstream out("test_static_config.cfg");
+        out << "host=example.org\n";
+        out << "port=80abc\n";  // śmieci na końcu liczby
+    }
+
+    TestStaticConfig cfg("test_static_config.cfg");
+    EXPECT_THROW(cfg.loadFromFile(), ConfigurationError);
+
+    // Nic nie zostało zastosowane
+    EXPECT_EQ(cfg.get<StaticParam::Port>(), 8080);
+    EXPECT_EQ(cfg.get<StaticParam::Host>(), "localhost");
+
+    std::remove("test_static_config.cfg");
+}
+
+TEST(ParseStrictTest, RejectsJunkAndOverflow)
+{
+    int i = 1;
+    EXPECT_TRUE(parseStrict("42", i));
+    EXPECT_EQ(i, 42);
+    EXPECT_FALSE(parseStrict("42x", i));
+    EXPECT_FALSE(parseStrict("", i));
+    EXPECT_FALSE(parseStrict("99999999999", i));
+    EXPECT_EQ(i, 42);
+
+    std::uint8_t small = 0;
+    EXPECT_FALSE(parseStrict("256", small));
+
+    bool b = false;
+    EXPECT_TRUE(parseStrict("true", b));
+    EXPECT_TRUE(b);
+    EXPECT_FALSE(parseStrict("yes", b));
+
+    double d = 0.0;
+    EXPECT_TRUE(parseStrict("2.5e3", d));
+    EXPECT_DOUBLE_EQ(d, 2500.0);
+}
@@ -0,0 +1,241 @@
+/*
+ * World VTT / cpp_config – tests publikacji konfiguracji w pamięci współdzielonej
+ *
+ * Uruchamiać także pod ThreadSanitizerem: make test-tsan
+ */
+
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ConfigChoice.h"
+#include "ConfigExceptions.h"
+#include "ConfigParameter.h"
+#include "ConfigShared.h"
+
+using namespace cpp_config;
+
+enum class ShmParam
+{
+    Port,
+    Timeout,
+    NoDelay,
+    Host,
+    Count,
+};
+
+using ShmConfig = Config<ShmParam>;
+
+static std::shared_ptr<const ShmConfig::Schema> MakeShmSchema()
+{
+    return ShmConfig::Schema::Builder()
+        .add(ShmParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "80", ConfigValue::Type::Integer))
+        .add(ShmParam::Timeout, std::make_shared<ConfigParameter>("timeout", "Timeout in seconds", "1.5", ConfigValue::Type::Floating))
+        .add(ShmParam::NoDelay, std::make_shared<ConfigParameter>("nodelay", "TCP_NODELAY", "true", ConfigValue::Type::Bool))
+        .add(ShmParam::Host, std::make_shared<ConfigParameter>("host", "Server host", "localhost"))
+        .build();
+}
+
+// Unikalna nazwa segmentu, żeby równoległe uruchomienia sobie nie przeszkadzały
+static std::string SegmentName(const char* test)
+{
+    return "/cpp_config_test_" + std::to_string(::getpid()) + "_" + test;
+}
+
+TEST(ConfigSharedTest, OtherProcessReadsPublishedValues)
+{
+    ShmConfig cfg(MakeShmSchema(), "test_shared_config.cfg");
+    cfg.set(ShmParam::Host, "db.example.com");
+    const std::string name = SegmentName("read");
+    SharedConfigPublisher<ShmParam> publisher(cfg, name);
+
+    pid_t child = ::fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        // proces potomny: bez asercji gtest, wynik w kodzie wyjścia
+        int code = 0;
+        try {
+            SharedConfigReader<ShmParam> reader(MakeShmSchema(), name);
+            if (reader.value<int>(ShmParam::Port) != 80) code = 1;
+            if (reader.value<double>(ShmParam::Timeout) != 1.5) code = 2;
+            if (!reader.value<bool>(ShmParam::NoDelay)) code = 3;
+            if (reader.value<std::string>(ShmParam::Host) != "db.example.com") code = 4;
+            if (reader.generation() == 0) code = 5;
+        } catch (...) {
+            code = 10;
+        }
+        ::_exit(code);
+    }
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
+
+TEST(ConfigSharedTest, PublishesOnlyNewGenerations)
+{
+    ShmConfig cfg(MakeShmSchema(), "test_shared_config.cfg");
+    SharedConfigPublisher<ShmParam> publisher(cfg, SegmentName("generations"));
+    SharedConfigReader<ShmParam> reader(MakeShmSchema(), publisher.name());
+
+    const std::uint64_t first = reader.generation();
+    EXPECT_EQ(first, cfg.generation());
+    EXPECT_FALSE(publisher.publish());
+
+    cfg.set(ShmParam::Port, "9000");
+    // czytelnik widzi zmianę dopiero po publikacji
+    EXPECT_EQ(reader.value<int>(ShmParam::Port), 80);
+    EXPECT_TRUE(publisher.publish());
+    EXPECT_EQ(reader.value<int>(ShmParam::Port), 9000);
+    EXPECT_EQ(reader.get(ShmParam::Port).raw(), "9000");
+    EXPECT_GT(reader.generation(), first);
+    EXPECT_THROW(reader.value<int>(ShmParam::Count), std::out_of_range);
+}
+
+TEST(ConfigSharedTest, ChoiceIndexCrossesSegment)
+{
+    enum class Mode
+    {
+        Off,
+        Fast,
+        Safe,
+    };
+    auto schema = ShmConfig::Schema::Builder()
+                      .add(ShmParam::Host, std::make_shared<ConfigChoice>("mode", "Mode", "fast", std::vector<std::string>{"off", "fast", "safe"}))
+                      .build();
+    ShmConfig cfg(schema, "test_shared_config.cfg");
+    SharedConfigPublisher<ShmParam> publisher(cfg, SegmentName("choice"));
+    SharedConfigReader<ShmParam> reader(schema, publisher.name());
+
+    EXPECT_EQ(reader.value<Mode>(ShmParam::Host), Mode::Fast);
+    cfg.set(ShmParam::Host, "safe");
+    publisher.publish();
+    EXPECT_EQ(reader.value<Mode>(ShmParam::Host), Mode::Safe);
+    EXPECT_EQ(reader.value<std::string>(ShmParam::Host), "safe");
+}
+
+TEST(ConfigSharedTest, ReaderNeverSeesTornValues)
+{
+    ShmConfig cfg(MakeShmSchema(), "test_shared_config.cfg");
+    SharedConfigPublisher<ShmParam> publisher(cfg, SegmentName("torn"));
+    SharedConfigReader<ShmParam> reader(MakeShmSchema(), publisher.name());
+
+    std::atomic<bool> stop{false};
+    std::thread thread([&]() {
+        std::uint64_t last = 0;
+        while (!stop.load()) {
+            // tekst i liczba pochodzą z tej samej publikacji
+            ConfigValue port = reader.get(ShmParam::Port);
+            EXPECT_EQ(std::to_string(port.as<std::int64_t>()), port.raw());
+            std::uint64_t generation = reader.generation();
+            EXPECT_GE(generation, last);
+            last = generation;
+        }
+    });
+
+    // zmienna długość tekstu przesuwa przesunięcia w obszarze tekstu
+    for (int i = 1; i <= 2000; ++i) {
+        cfg.set(ShmParam::Port, std::to_string(i % 2 ? i : i * 1000003));
+        publisher.publish();
+    }
+    stop.store(true);
+    thread.join();
+    EXPECT_EQ(reader.value<int>(ShmParam::Port), 2000 * 1000003);
+}
+
+TEST(ConfigSharedTest, ReaderGivesUpOnUnfinishedWrite)
+{
+    ShmConfig cfg(MakeShmSchema(), "test_shared_config.cfg");
+    SharedConfigPublisher<ShmParam> publisher(cfg, SegmentName("unfinished"));
+    SharedConfigReader<ShmParam> reader(MakeShmSchema(), publisher.name(), std::chrono::milliseconds(50));
+
+    // nieparzysty licznik sekwencji (słowo 8), jak po śmierci wydawcy w trakcie zapisu
+    int fd = ::shm_open(publisher.name().c_str(), O_RDWR, 0);
+    ASSERT_GE(fd, 0);
+    void* mapping = ::mmap(nullptr, 16 * sizeof(std::uint64_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    ASSERT_NE(mapping, MAP_FAILED);
+    std::atomic_ref<std::uint64_t> sequence(static_cast<std::uint64_t*>(mapping)[8]);
+    sequence.fetch_add(1);
+
+    EXPECT_THROW(reader.get(ShmParam::Port), ConfigurationError);
+    EXPECT_THROW(reader.generation(), ConfigurationError);
+
+    // dokończony zapis -> odczyty znów działają
+    sequence.fetch_add(1);
+    EXPECT_EQ(reader.value<int>(ShmParam::Port), 80);
+    ::munmap(mapping, 16 * sizeof(std::uint64_t));
+}
+
+TEST(ConfigSharedTest, RejectsMismatchedSegments)
+{
+    ShmConfig cfg(MakeShmSchema(), "test_shared_config.cfg");
+    std::string name = SegmentName("mismatch");
+
+    EXPECT_THROW((SharedConfigReader<ShmParam>(MakeShmSchema(), name)), ConfigurationError);
+    // tekst wartości nie mieści się w segmencie
+    EXPECT_THROW((SharedConfigPublisher<ShmParam>(cfg, name, 8)), ConfigurationError);
+
+    {
+        SharedConfigPublisher<ShmParam> publisher(cfg, name);
+        auto other = ShmConfig::Schema::Builder()
+                         .add(ShmParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "80", ConfigValue::Type::Integer))
+                         .build();
+        EXPECT_THROW((SharedConfigReader<ShmParam>(other, name)), ConfigurationError);
+
+        // za długa wartość nie psuje opublikowanej tabeli
+        SharedConfigPublisher<ShmParam> small(cfg, name + "_small", 64);
+        SharedConfigReader<ShmParam> reader(MakeShmSchema(), small.name());
+        cfg.set(ShmParam::Host, std::string(100, 'h'));
+        EXPECT_THROW(small.publish(), ConfigurationError);
+        EXPECT_EQ(reader.value<std::string>(ShmParam::Host), "localhost");
+    }
+    // publisher usuwa nazwę segmentu
+    EXPECT_THROW((SharedConfigReader<ShmParam>(MakeShmSchema(), name)), ConfigurationError);
+}
+
+// Uprawnienia segmentu, odczytane przez jego nazwę
+static ::mode_t SegmentMode(const std::string& name)
+{
+    int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    struct stat info {};
+    const bool ok = fd >= 0 && ::fstat(fd, &info) == 0;
+    if (fd >= 0) {
+        ::close(fd);
+    }
+    return ok ? info.st_mode & 0777 : 0;
+}
+
+TEST(ConfigSharedTest, SegmentsArePrivateAndNeverTakenOver)
+{
+    ShmConfig cfg(MakeShmSchema(), "test_shared_config.cfg");
+    std::string name = SegmentName("owner");
+
+    SharedConfigPublisher<ShmParam> publisher(cfg, name);
+    EXPECT_EQ(SegmentMode(name), 0600u);
+
+    // zajęta nazwa to błąd, segment działającego wydawcy zostaje nietknięty
+    ShmConfig other(MakeShmSchema(), "test_shared_config.cfg");
+    other.set(ShmParam::Port, "9000");
+    EXPECT_THROW((SharedConfigPublisher<ShmParam>(other, name)), ConfigurationError);
+    SharedConfigReader<ShmParam> reader(MakeShmSchema(), name);
+    EXPECT_EQ(reader.value<int>(ShmParam::Port), 80);
+
+    // segment po zmarłym wydawcy usuwa się jawnie
+    SharedSegment::remove(name);
+    SharedConfigPublisher<ShmParam> replacement(other, name, 64 * 1024, 0644);
+    EXPECT_EQ(SegmentMode(name), 0644u);
+    EXPECT_EQ(SharedConfigReader<ShmParam>(MakeShmSchema(), name).value<int>(ShmParam::Port), 9000);
+    EXPECT_EQ(reader.value<int>(ShmParam::Port), 80);
+}
@@ -0,0 +1,182 @@
+/*
+ * World VTT / cpp_config – tests warstwowych źródeł konfiguracji
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>   // std::remove
+#include <cstdlib>  // setenv, unsetenv
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "Config.h"
+#include "ConfigExceptions.h"
+#include "ConfigParameter.h"
+#include "ConfigSources.h"
+
+using namespace cpp_config;
+
+enum class LayerParam
+{
+    Port,
+    Host,
+    Verbose,
+    Ratio,
+    Count,
+};
+
+using LayerConfig = Config<LayerParam>;
+
+static std::shared_ptr<const LayerConfig::Schema> MakeLayerSchema()
+{
+    return LayerConfig::Schema::Builder()
+        .add(LayerParam::Port, std::make_shared<ConfigParameter>("server.port", "TCP port", "8080", ConfigValue::Type::Integer))
+        .add(LayerParam::Host, std::make_shared<ConfigParameter>("server.host", "Server host", "localhost"))
+        .add(LayerParam::Verbose, std::make_shared<ConfigParameter>("verbose", "Verbose output", "false", ConfigValue::Type::Bool))
+        .add(LayerParam::Ratio, std::make_shared<ConfigParameter>("ratio", "Ratio", "0.5", ConfigValue::Type::Floating))
+        .build();
+}
+
+static void WriteFile(const std::string& path, const std::string& content)
+{
+    std::ofstream out(path);
+    out << content;
+}
+
+// ===================================================
+//  TESTY: ConfigSources
+// ===================================================
+
+TEST(ConfigSourcesTest, EnvironmentName)
+{
+    EXPECT_EQ(ConfigSources::environmentName("APP_", "server.port"), "APP_SERVER_PORT");
+    EXPECT_EQ(ConfigSources::environmentName("", "max-size"), "MAX_SIZE");
+}
+
+TEST(ConfigSourcesTest, CommandLineForms)
+{
+    const char* argv[] = {"app", "--server.port=9000", "input.txt", "--server.host", "example.org", "--verbose", "--ratio=0.25"};
+    ConfigSources sources;
+    sources.commandLine(7, argv);
+
+    ASSERT_EQ(sources.layers().size(), 1u);
+    const auto options = ConfigSources::options(sources.layers()[0], [](std::string_view name) { return name == "server.host"; });
+    ASSERT_EQ(options.size(), 4u);
+    EXPECT_EQ(options[0], (std::pair<std::string, std::string>{"server.port", "9000"}));
+    EXPECT_EQ(options[1], (std::pair<std::string, std::string>{"server.host", "example.org"}));
+    EXPECT_EQ(options[2], (std::pair<std::string, std::string>{"verbose", "true"}));
+    EXPECT_EQ(options[3], (std::pair<std::string, std::string>{"ratio", "0.25"}));
+}
+
+TEST(ConfigSourcesTest, CommandLineFlagsDoNotSwallowArguments)
+{
+    const char* argv[] = {"app", "--dry-run", "input.txt", "--server.host", "example.org", "--", "--server.port=1"};
+    ConfigSources sources;
+    sources.commandLine(7, argv);
+
+    // tylko zarejestrowana nazwa bierze osobną wartość; po `--` nic nie jest opcją
+    const auto options = ConfigSources::options(sources.layers()[0], [](std::string_view name) { return name == "server.host"; });
+    ASSERT_EQ(options.size(), 2u);
+    EXPECT_EQ(options[0], (std::pair<std::string, std::string>{"dry-run", "true"}));
+    EXPECT_EQ(options[1], (std::pair<std::string, std::string>{"server.host", "example.org"}));
+}
+
+// ===================================================
+//  TESTY: Config::load(ConfigSources)
+// ===================================================
+
+TEST(ConfigLayersTest, LaterLayersWinAndSourcesAreRecorded)
+{
+    LayerConfig cfg(MakeLayerSchema(), "test_layers.cfg");
+    WriteFile("test_layers_base.cfg", "server.port=1000\nserver.host=base.example\nratio=0.75\n");
+    WriteFile("test_layers_local.cfg", "server.port=2000\n");
+    setenv("TESTLAYERS_SERVER_HOST", "env.example", 1);
+    const char* argv[] = {"app", "--verbose"};
+
+    cfg.load(ConfigSources()
+                 .file("test_layers_base.cfg")
+                 .file("test_layers_local.cfg")
+                 .file("test_layers_missing.cfg", true)
+                 .environment("TESTLAYERS_")
+                 .commandLine(2, argv));
+
+    EXPECT_EQ(cfg.value<int>(LayerParam::Port), 2000);
+    EXPECT_EQ(cfg.value<std::string>(LayerParam::Host), "env.example");
+    EXPECT_TRUE(cfg.value<bool>(LayerParam::Verbose));
+    EXPECT_DOUBLE_EQ(cfg.value<double>(LayerParam::Ratio), 0.75);
+
+    EXPECT_EQ(cfg.source(LayerParam::Port).kind, ValueSource::Kind::File);
+    EXPECT_EQ(cfg.source(LayerParam::Port).name, "test_layers_local.cfg");
+    EXPECT_EQ(cfg.source(LayerParam::Host).kind, ValueSource::Kind::Environment);
+    EXPECT_EQ(cfg.source(LayerParam::Host).name, "TESTLAYERS_SERVER_HOST");
+    EXPECT_EQ(cfg.source(LayerParam::Verbose).kind, ValueSource::Kind::CommandLine);
+    EXPECT_EQ(cfg.source(LayerParam::Verbose).name, "--verbose");
+    EXPECT_EQ(cfg.source(LayerParam::Ratio).name, "test_layers_base.cfg");
+
+    unsetenv("TESTLAYERS_SERVER_HOST");
+    std::remove("test_layers_base.cfg");
+    std::remove("test_layers_local.cfg");
+}
+
+TEST(ConfigLayersTest, MixedCommandLineArguments)
+{
+    LayerConfig cfg(MakeLayerSchema(), "test_layers.cfg");
+    const char* argv[] = {"app", "--unknown", "input.txt", "--verbose", "output.txt", "--server.host", "example.org",
+                          "--ratio", "0.25", "extra", "--", "--server.port=1"};
+
+    // nieznane opcje i flagi typu bool nie połykają argumentów pozycyjnych
+    cfg.load(ConfigSources().commandLine(12, argv));
+
+    EXPECT_TRUE(cfg.value<bool>(LayerParam::Verbose));
+    EXPECT_EQ(cfg.value<std::string>(LayerParam::Host), "example.org");
+    EXPECT_DOUBLE_EQ(cfg.value<double>(LayerParam::Ratio), 0.25);
+    EXPECT_EQ(cfg.value<int>(LayerParam::Port), 8080);
+    EXPECT_EQ(cfg.source(LayerParam::Port).kind, ValueSource::Kind::Default);
+}
+
+TEST(ConfigLayersTest, KeysNotSetByAnyLayerReturnToDefault)
+{
+    LayerConfig cfg(MakeLayerSchema(), "test_layers.cfg");
+    cfg.set(LayerParam::Port, "9999");
+    EXPECT_EQ(cfg.source(LayerParam::Port).kind, ValueSource::Kind::Runtime);
+
+    WriteFile("test_layers_base.cfg", "server.host=base.example\n");
+    cfg.load(ConfigSources().file("test_layers_base.cfg"));
+
+    EXPECT_EQ(cfg.value<int>(LayerParam::Port), 8080);
+    EXPECT_EQ(cfg.source(LayerParam::Port).kind, ValueSource::Kind::Default);
+    EXPECT_EQ(cfg.value<std::string>(LayerParam::Host), "base.example");
+
+    std::remove("test_layers_base.cfg");
+}
+
+TEST(ConfigLayersTest, RejectedLoadKeepsPreviousValues)
+{
+    LayerConfig cfg(MakeLayerSchema(), "test_layers.cfg");
+    cfg.set(LayerParam::Port, "1234");
+
+    EXPECT_THROW(cfg.load(ConfigSources().file("test_layers_missing.cfg")), ConfigurationError);
+
+    const char* argv[] = {"app", "--server.port=not-a-number"};
+    EXPECT_THROW(cfg.load(ConfigSources().commandLine(2, argv)), ConfigurationError);
+
+    EXPECT_EQ(cfg.value<int>(LayerParam::Port), 1234);
+    EXPECT_EQ(cfg.source(LayerParam::Port).kind, ValueSource::Kind::Runtime);
+}
+
+TEST(ConfigLayersTest, LoadFromFileRecordsFileSource)
+{
+    LayerConfig cfg(MakeLayerSchema(), "test_layers.cfg");
+    WriteFile("test_layers.cfg", "ratio=0.125\n");
+
+    cfg.loadFromFile();
+
+    EXPECT_EQ(cfg.source(LayerParam::Ratio).kind, ValueSource::Kind::File);
+    EXPECT_EQ(cfg.source(LayerParam::Ratio).name, "test_layers.cfg");
+    EXPECT_EQ(cfg.source(LayerParam::Port).kind, ValueSource::Kind::Default);
+    EXPECT_STREQ(toString(cfg.source(LayerParam::Port).kind), "default");
+
+    std::remove("test_layers.cfg");
+}
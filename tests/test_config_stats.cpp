@@ -0,0 +1,188 @@
+/*
+ * World VTT / cpp_config – tests statystyk odczytów i przeładowań
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>  // std::remove
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Config.h"
+#include "ConfigParameter.h"
+#include "ConfigStats.h"
+
+using namespace cpp_config;
+
+enum class StatsParam
+{
+    Port,
+    Host,
+    Extra,
+    Count,
+};
+
+// Klucze bez `Count` -> przechowywanie w mapie
+enum class ManyStatsParam : int
+{
+};
+
+enum class PlainStatsParam
+{
+    Port,
+    Count,
+};
+
+namespace cpp_config {
+template<>
+struct ConfigStatsTraits<StatsParam>
+{
+    static constexpr bool enabled = true;
+};
+
+template<>
+struct ConfigStatsTraits<ManyStatsParam>
+{
+    static constexpr bool enabled = true;
+};
+
+template<>
+struct ConfigStatsTraits<PlainStatsParam>
+{
+    static constexpr bool enabled = false;
+};
+}  // namespace cpp_config
+
+using StatsConfig = Config<StatsParam>;
+
+// Bez statystyk Config nie ma nawet liczników
+static_assert(!Config<PlainStatsParam>::Stats);
+static_assert(sizeof(Config<PlainStatsParam>) < sizeof(StatsConfig));
+
+static std::shared_ptr<const StatsConfig::Schema> MakeStatsSchema()
+{
+    return StatsConfig::Schema::Builder()
+        .add(StatsParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "80", ConfigValue::Type::Integer))
+        .add(StatsParam::Host, std::make_shared<ConfigParameter>("host", "Server host", "localhost"))
+        .build();
+}
+
+static uint64_t ReadsOf(const ConfigStatistics& stats, const std::string& name)
+{
+    for (const auto& param : stats.reads) {
+        if (param.name == name) {
+            return param.count;
+        }
+    }
+    return 0;
+}
+
+TEST(ConfigStatsTest, CountsReadsPerParameterAcrossThreads)
+{
+    StatsConfig cfg(MakeStatsSchema(), "test_stats_config.cfg");
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&cfg]() {
+            for (int i = 0; i < 1000; ++i) {
+                cfg.value<int>(StatsParam::Port);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    cfg.get(StatsParam::Host);
+    cfg.snapshot()->get(StatsParam::Host);  // odczyt przez migawkę nie jest liczony
+
+    ConfigStatistics stats = cfg.statistics();
+    EXPECT_EQ(ReadsOf(stats, "port"), 4000u);
+    EXPECT_EQ(ReadsOf(stats, "host"), 1u);
+}
+
+TEST(ConfigStatsTest, RegisteringParametersKeepsEarlierCounts)
+{
+    StatsConfig cfg(MakeStatsSchema(), "test_stats_config.cfg");
+    cfg.value<int>(StatsParam::Port);
+
+    cfg.addParam(StatsParam::Extra, std::make_shared<ConfigParameter>("extra", "Extra", "x"));
+    cfg.value<int>(StatsParam::Port);
+    cfg.value<std::string>(StatsParam::Extra);
+
+    ConfigStatistics stats = cfg.statistics();
+    ASSERT_EQ(stats.reads.size(), 3u);
+    EXPECT_EQ(ReadsOf(stats, "port"), 2u);
+    EXPECT_EQ(ReadsOf(stats, "extra"), 1u);
+
+    cfg.clear();
+    EXPECT_TRUE(cfg.statistics().reads.empty());
+    EXPECT_EQ(cfg.statistics().reloads, 0u);
+}
+
+TEST(ConfigStatsTest, InterleavedRegistrationsKeepEveryCount)
+{
+    Config<ManyStatsParam> cfg(Config<ManyStatsParam>::Schema::Builder().build(), "test_stats_many.cfg");
+
+    // każdy odczyt zamraża nowy klucz – liczniki rosną razem z tabelą
+    for (int i = 0; i < 300; ++i) {
+        cfg.addParam(static_cast<ManyStatsParam>(i), std::make_shared<ConfigParameter>("key" + std::to_string(i), "d", "1"));
+        cfg.value<int>(static_cast<ManyStatsParam>(0));
+        cfg.value<int>(static_cast<ManyStatsParam>(i));
+    }
+    ConfigStatistics stats = cfg.statistics();
+    ASSERT_EQ(stats.reads.size(), 300u);
+    EXPECT_EQ(ReadsOf(stats, "key0"), 301u);
+    EXPECT_EQ(ReadsOf(stats, "key1"), 1u);
+    EXPECT_EQ(ReadsOf(stats, "key299"), 1u);
+}
+
+TEST(ConfigStatsTest, CountsReloadsAndProblemsInFiles)
+{
+    StatsConfig cfg(MakeStatsSchema(), "test_stats_config.cfg");
+    {
+        std::ofstream out("test_stats_config.cfg");
+        out << "port = 9000\n";
+        out << "unknown = 1\n";
+        out << "bez znaku rownosci\n";
+    }
+    cfg.loadFromFile();
+    {
+        std::ofstream out("test_stats_config.cfg");
+        out << "port = abc\n";
+    }
+    EXPECT_THROW(cfg.loadFromFile(), ConfigurationError);
+
+    ConfigStatistics stats = cfg.statistics();
+    EXPECT_EQ(stats.reloads, 2u);
+    EXPECT_EQ(stats.failedReloads, 1u);
+    EXPECT_EQ(stats.unknownKeys, 1u);
+    EXPECT_EQ(stats.malformedLines, 1u);
+    EXPECT_EQ(stats.rejectedValues, 1u);
+
+    uint64_t histogram = 0;
+    for (uint64_t bucket : stats.reloadHistogram) {
+        histogram += bucket;
+    }
+    EXPECT_EQ(histogram, 2u);
+    EXPECT_GT(stats.reloadTotal.count(), 0);
+    EXPECT_LE(stats.reloadMax, stats.reloadTotal);
+
+    const std::string dump = stats.toString();
+    EXPECT_NE(dump.find("reloads: 2 (failed: 1)"), std::string::npos);
+    EXPECT_NE(dump.find("rejected values: 1\n"), std::string::npos);
+    EXPECT_NE(dump.find("  port: 0\n"), std::string::npos);
+
+    std::remove("test_stats_config.cfg");
+}
+
+TEST(ConfigStatsTest, ReloadBucketsFollowBounds)
+{
+    using std::chrono::microseconds;
+    EXPECT_EQ(ConfigStatistics::bucketOf(microseconds(1)), 0u);
+    EXPECT_EQ(ConfigStatistics::bucketOf(microseconds(10)), 0u);
+    EXPECT_EQ(ConfigStatistics::bucketOf(microseconds(11)), 1u);
+    EXPECT_EQ(ConfigStatistics::bucketOf(std::chrono::seconds(5)), ConfigStatistics::ReloadBuckets - 1);
+}
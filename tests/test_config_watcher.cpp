@@ -0,0 +1,157 @@
+/*
+ * World VTT / cpp_config – tests powiadomień o zmianach i obserwatora pliku
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>  // std::remove
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Config.h"
+#include "ConfigParameter.h"
+
+using namespace cpp_config;
+
+enum class WatchParam
+{
+    Port,
+    Host,
+    Count,
+};
+
+using WatchConfig = Config<WatchParam>;
+
+namespace cpp_config {
+template<>
+const std::string Config<WatchParam>::_confFileName = "test_watch_config.cfg";
+}  // namespace cpp_config
+
+static WatchConfig& SetupWatchConfig()
+{
+    auto& cfg = WatchConfig::instance();
+    cfg.clear();
+    cfg.addParam(WatchParam::Port, std::make_shared<ConfigParameter>("port", "TCP port", "8080"));
+    cfg.addParam(WatchParam::Host, std::make_shared<ConfigParameter>("host", "Server host", "localhost"));
+    return cfg;
+}
+
+TEST(ConfigChangeCallbackTest, FiresOnlyForChangedKeys)
+{
+    auto& cfg = SetupWatchConfig();
+
+    std::vector<std::string> portChanges;
+    int hostChanges = 0;
+    cfg.onChange(WatchParam::Port, [&portChanges](const ConfigParameter& previous, const ConfigParameter& current) {
+        portChanges.push_back(previous.value() + "->" + current.value());
+    });
+    cfg.onChange(WatchParam::Host, [&hostChanges](const ConfigParameter&, const ConfigParameter&) { ++hostChanges; });
+
+    {
+        std::ofstream out("test_watch_config.cfg");
+        out << "port=9000\n";
+        out << "host=localhost\n";  // bez zmian -> brak powiadomienia
+    }
+    cfg.loadFromFile();
+
+    ASSERT_EQ(portChanges.size(), 1u);
+    EXPECT_EQ(portChanges[0], "8080->9000");
+    EXPECT_EQ(hostChanges, 0);
+
+    // Ponowne wczytanie tego samego pliku niczego nie zmienia
+    cfg.loadFromFile();
+    EXPECT_EQ(portChanges.size(), 1u);
+
+    cfg.clear();
+    std::remove("test_watch_config.cfg");
+}
+
+TEST(ConfigChangeCallbackTest, ThrowingCallbackDoesNotStopOthers)
+{
+    auto& cfg = SetupWatchConfig();
+
+    std::vector<std::string> errors;
+    int portChanges = 0;
+    int hostChanges = 0;
+    cfg.onCallbackError([&errors](std::exception_ptr error) {
+        try {
+            std::rethrow_exception(error);
+        } catch (const std::exception& e) {
+            errors.push_back(e.what());
+        }
+    });
+    cfg.onChange(WatchParam::Port, [](const ConfigParameter&, const ConfigParameter&) { throw std::runtime_error("port"); });
+    cfg.onChange(WatchParam::Port, [&portChanges](const ConfigParameter&, const ConfigParameter&) { ++portChanges; });
+    cfg.onChange(WatchParam::Host, [&hostChanges](const ConfigParameter&, const ConfigParameter&) { ++hostChanges; });
+
+    {
+        std::ofstream out("test_watch_config.cfg");
+        out << "port=9000\n";
+        out << "host=game.example\n";
+    }
+    // zmiana jest już opublikowana, więc wyjątek wywołania zwrotnego nie
+    // dociera do wywołującego
+    EXPECT_NO_THROW(cfg.loadFromFile());
+    EXPECT_EQ(cfg.value<int>(WatchParam::Port), 9000);
+    EXPECT_EQ(portChanges, 1);
+    EXPECT_EQ(hostChanges, 1);
+    EXPECT_EQ(errors, std::vector<std::string>{"port"});
+
+    // bez obsługi błędów wyjątek jest pomijany
+    cfg.onCallbackError(nullptr);
+    EXPECT_NO_THROW(cfg.set(WatchParam::Port, "9001"));
+    EXPECT_EQ(portChanges, 2);
+
+    cfg.clear();
+    std::remove("test_watch_config.cfg");
+}
+
+TEST(ConfigWatcherTest, ReloadsWhenFileChanges)
+{
+    {
+        std::ofstream out("test_watch_config.cfg");
+        out << "port=8080\n";
+    }
+    auto& cfg = SetupWatchConfig();
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    int notifications = 0;
+    cfg.onChange(WatchParam::Port, [&](const ConfigParameter&, const ConfigParameter&) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++notifications;
+        changed.notify_all();
+    });
+
+    cfg.startWatching(std::chrono::milliseconds(50));
+
+    // Seria zapisów powinna dać jedno przeładowanie
+    for (int port = 9001; port <= 9003; ++port) {
+        std::ofstream out("test_watch_config.cfg");
+        out << "port=" << port << "\n";
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(changed.wait_for(lock, std::chrono::seconds(5), [&notifications]() { return notifications > 0; }));
+    }
+    EXPECT_EQ(cfg.value<int>(WatchParam::Port), 9003);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        EXPECT_EQ(notifications, 1);
+    }
+
+    cfg.stopWatching();
+    cfg.clear();
+    std::remove("test_watch_config.cfg");
+}